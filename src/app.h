@@ -0,0 +1,169 @@
+/**********************
+    Shared by the sketch (hardware, speed and gps tasks, display flush) and screens.cpp (lvgl screens).
+    The native env builds screens.cpp and scenarios.cpp against src/native instead of the sketch.
+ **********************/
+#ifndef APP_H
+#define APP_H
+
+#include <Arduino.h>
+#include "lvgl/lvgl.h"                   //This is the graphics library
+#include "speed_math.h"                  //filter_* values of speed_avg
+
+#define serial_debug   1            //set to '1'  to show debug lines in serial monitor
+
+/**********************
+    Define Colors
+ **********************/
+#define BLACK 0x0000                //declare constants for colors
+#define NAVY 0x000F
+#define DARKGREEN 0x03E0
+#define DARKCYAN 0x03EF
+#define MAROON 0x7800
+#define PURPLE 0x780F
+#define OLIVE 0x7BE0
+#define LIGHTGREY 0xC618
+#define DARKGREY 0x7BEF
+#define BLUE 0x001F
+#define GREEN 0x07E0
+#define CYAN 0x07FF
+#define RED 0xF800
+#define MAGENTA 0xF81F
+#define YELLOW 0xFFE0
+#define WHITE 0xFFFF
+#define ORANGE 0xFD20
+#define GREENYELLOW 0xAFE5
+#define PINK 0xF81F
+
+/*********************
+   EEPROM varibles
+ *********************/
+//EEprom address values
+#define unit_ee_adr 1                              //location 1, 0= mph 1= kph 2= dis 3= mpm
+#define guage_ee_adr 2                             //location 2, 0 = digital readout, 1 = analog meter readout 2= bar graph
+#define cal_ee_edr 5                               //calibration number (float number
+#define security_ee_adr 10                         //Enable Security check box
+#define graph_ee_adr 11                            //status of enable bar graph check box
+#define dis_ee_adr 12                              //distance checkbox status
+#define alarm_ee_adr 13                           //alarm status
+#define speed_target_ee_adr 15                     //target speed (float number)
+#define fpm_ee_adr 21                              //feet per minute checkbox
+#define upw_ee_adr 25                              //user password code
+#define speed_avg_ee_adr 29                        //speed filter 0 = none 1 = average (3:1) 2 = alpha-beta 3 = kalman 4 = median + kalman
+#define screen_cal_ee_adr 35                       //set to 0 to force screen calibration and 1 to prevent screen calibration
+#define speed_input_ee_adr 40                      //0= radar or wheelpulse  input, 1 = gps input, 2 = u-blox gps (UBX binary)
+#define ALR1_ee_adr 45                             //alarm 1 value
+#define ALR2_ee_adr 50                             //alarm 2 value
+#define ALR3_ee_adr 55                             //alarm 3 value
+#define ALR4_ee_adr 60                             //alarm 4 value
+#define speed_mode_ee_adr 65                       //speed calculation mode 0 = 250ms pulse count, 1 = per pulse timing, 2 = adaptive gate
+
+/**********************
+    speed samples from the speed task (core 0) to the screen (loop, core 1)
+    one slot queue written with xQueueOverwrite so the screen only ever gets the newest reading
+ **********************/
+#define gps_none 0                                 //no gps sentence since last reading
+#define gps_locked 1                               //gps has a valid position
+#define gps_searching 2                            //gps sentence without a valid position
+struct speed_sample {
+  uint32_t time;                                   //micros() when the reading was made
+  int32_t mph_q16;                                 //speed in mph (Q16)
+  int32_t disp_q16;                                //speed in display units (Q16)
+  byte gps_status;
+};
+
+/**********************
+    settings (screens.cpp, saved in eeprom)
+ **********************/
+extern int cal_number;
+extern int old_cal_number;
+extern int run_screen_flag;
+extern byte units;
+extern bool field_cal_flag;
+extern byte security;
+extern byte dis;
+extern byte graph;
+extern byte alarm_enable;
+extern byte fpm;
+extern String user_passcode;
+extern float speed_target;
+extern byte speed_avg;
+extern byte speed_input;
+extern float ALR1,ALR2,ALR3,ALR4;
+extern byte speed_mode;
+/**********************
+    screen objects the sketch and the render scenarios use (screens.cpp)
+ **********************/
+extern lv_obj_t * label_speed;
+extern lv_obj_t * mbox1;
+extern lv_obj_t * lab_diag;
+extern lv_obj_t * label_gps_search_icon;
+extern lv_obj_t * label_gps_lock_icon;
+extern lv_obj_t * option_descrip_text;
+extern lv_obj_t * calibrate_descrip_text;
+extern lv_obj_t * close_descrip_text;
+extern uint32_t bind_applied;
+extern uint32_t bind_skipped;
+extern lv_obj_t * btn_setup;                       //buttons the native env's touch script presses
+extern lv_obj_t * cb_mph;
+extern lv_obj_t * cb_kph;
+extern lv_obj_t * btn_set_exit;
+extern lv_obj_t * btn_exit;
+extern lv_obj_t * btn_show_alarms;
+extern lv_obj_t * btn_alarm_set_exit;
+/**********************
+    hardware state the screens change (sketch, src/native on the native env)
+ **********************/
+extern bool REPEAT_CAL;
+extern int var_REPEAT_CAL;
+extern long old_millis;
+extern bool field_calibration_flag;
+extern volatile bool filter_reset_request;
+extern uint32_t refr_last_px;                      //pixels of the newest redraw (monitor_cb)
+/**********************
+    render scenarios (scenarios.cpp)
+ **********************/
+struct scen_stats {
+  const char * name;
+  uint32_t frames;
+  uint32_t us;                                      //total frame time, draw and send to the display
+  uint32_t us_max;
+  uint32_t px;                                      //total pixels redrawn
+  uint32_t visits;                                  //total objects visited by the redraws
+};
+extern volatile bool scen_hash_on;
+extern uint32_t scen_hash;
+extern void (*scen_frame_cb)(const char * name, uint32_t frame);   //called after every scenario frame, NULL on the esp32
+
+//screens.cpp
+void build_screens(void);
+void screen_run_on(void);
+void screen_run_off(void);
+void option_screen_on(void);
+void option_screen_off(void);
+void screen_calibrate_on(void);
+void screen_calibrate_off(void);
+void field_calibrate_on(void);
+void field_calibrate_off(void);
+void screen_target_on(void);
+void screen_target_off(void);
+void screen_factory_on(void);
+void screen_factory_off(void);
+void lv_ex_mbox_1(void);
+void set_alarm_cb(lv_obj_t * obj, lv_event_t event);
+void show_speed(const speed_sample * sample);
+//sketch (hardware), stubbed in src/native
+void calculate_speed_constant(void);
+void enable_gps(void);
+void enable_radar(void);
+void set_gate_timer(void);
+void touch_calibrate();
+uint32_t field_pulse_count(void);
+void field_pulse_reset(void);
+void flush_wait(void);
+//scenarios.cpp
+uint32_t frame_hash(uint32_t hash, const lv_area_t * area, const lv_color_t * color_p, uint32_t n);
+void scen_frame(scen_stats * st);
+void scen_print(const scen_stats * st);
+void scen_run(bool hash);
+
+#endif
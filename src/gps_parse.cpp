@@ -0,0 +1,278 @@
+/**********************
+    gps parsers (see gps_parse.h)
+ **********************/
+#include "gps_parse.h"
+
+static void nmea_clear_field(nmea_parser * p) {                                 //start of a new field
+  p->value = 0;
+  p->decimals = nmea_no_point;
+  p->digits = false;
+  p->bad_number = false;
+  p->letter = 0;
+}
+static void nmea_field_char(nmea_parser * p, char c) {                          //one character of a field
+  if (p->field == 0) {                                                          //address field, talker + sentence ("GPRMC")
+    if (p->id_len < 5) {
+      p->id[p->id_len++] = c;
+      }
+    return;
+    }
+  if (p->letter == 0) {
+    p->letter = c;
+    }
+  if (c >= '0' && c <= '9') {
+    p->digits = true;
+    if (p->bad_number == true) {
+      return;
+      }
+    if (p->decimals == nmea_no_point) {
+      if (p->value > 214747) {                                                  //too big to hold x1000
+        p->bad_number = true;
+        }
+      else {
+        p->value = p->value * 10 + (c - '0');
+        }
+      }
+    else if (p->decimals < 3) {                                                 //keep 3 decimal places, drop the rest
+      p->value = p->value * 10 + (c - '0');
+      p->decimals = p->decimals + 1;
+      }
+    }
+  else if (c == '.' && p->decimals == nmea_no_point) {
+    p->decimals = 0;
+    }
+  else if (c != '-') {
+    p->bad_number = true;
+    }
+}
+static bool nmea_number(nmea_parser * p, int32_t * out) {                       //field as a number x1000, false if empty or not a number
+  if (p->digits == false || p->bad_number == true) {
+    return false;
+    }
+  int32_t v = p->value;
+  uint8_t d = (p->decimals == nmea_no_point) ? 0 : p->decimals;
+  for (; d < 3; d++) {
+    v = v * 10;
+    }
+  if (p->letter == '-') {
+    v = -v;
+    }
+  *out = v;
+  return true;
+}
+static void nmea_end_field(nmea_parser * p) {                                   //decode the field that just ended
+  gps_fix * w = &p->work;
+  int32_t v;
+  if (p->field == 0) {                                                          //sentence type is the last 3 letters of the address
+    w->type = nmea_none;
+    if (p->id_len == 5) {
+      if (p->id[2] == 'R' && p->id[3] == 'M' && p->id[4] == 'C') w->type = nmea_rmc;
+      if (p->id[2] == 'G' && p->id[3] == 'G' && p->id[4] == 'A') w->type = nmea_gga;
+      if (p->id[2] == 'V' && p->id[3] == 'T' && p->id[4] == 'G') w->type = nmea_vtg;
+      }
+    return;
+    }
+  switch (w->type) {
+    case nmea_rmc:                                                              //$GPRMC,time,status,lat,N,lon,W,speed,course,date,...
+      if (p->field == 1 && nmea_number(p, &v)) {
+        w->utc_valid = true;
+        w->utc_ms = (uint32_t)v;
+        }
+      if (p->field == 2) w->valid = (p->letter == 'A');
+      if (p->field == 7) w->speed_valid = nmea_number(p, &w->speed_mknots);
+      if (p->field == 8) w->course_valid = nmea_number(p, &w->course_mdeg);
+      break;
+    case nmea_gga:                                                              //$GPGGA,time,lat,N,lon,W,quality,...
+      if (p->field == 1 && nmea_number(p, &v)) {
+        w->utc_valid = true;
+        w->utc_ms = (uint32_t)v;
+        }
+      if (p->field == 6 && nmea_number(p, &v)) {
+        w->quality = (uint8_t)(v / 1000);
+        w->valid = (w->quality > 0);
+        }
+      break;
+    case nmea_vtg:                                                              //$GPVTG,course,T,course,M,speed,N,speed,K,mode
+      if (p->field == 1) w->course_valid = nmea_number(p, &w->course_mdeg);
+      if (p->field == 5) w->speed_valid = nmea_number(p, &w->speed_mknots);
+      if (p->field == 9) w->valid = (p->letter != 'N');
+      break;
+    }
+}
+static uint8_t nmea_hex(char c) {                                               //hex digit to value, 0xFF if not hex
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return 0xFF;
+}
+uint8_t nmea_feed(nmea_parser * p, char c) {                                    //feed one character, returns sentence type when a good sentence ends
+  if (c == '$') {                                                               //start of sentence, drop anything unfinished
+    p->state = 1;
+    p->sum = 0;
+    p->len = 0;
+    p->field = 0;
+    p->id_len = 0;
+    p->work = gps_fix();
+    p->work.type = nmea_none;
+    p->work.valid = true;                                                       //VTG without a mode field is valid
+    nmea_clear_field(p);
+    return nmea_none;
+    }
+  switch (p->state) {
+    case 1:
+      p->len = p->len + 1;
+      if (p->len > nmea_max_len || c == '\r' || c == '\n') {                   //too long, or ended without a checksum
+        p->state = 0;
+        return nmea_none;
+        }
+      if (c == '*') {
+        nmea_end_field(p);
+        p->state = 2;
+        return nmea_none;
+        }
+      p->sum = p->sum ^ c;
+      if (c == ',') {
+        nmea_end_field(p);
+        p->field = p->field + 1;
+        nmea_clear_field(p);
+        }
+      else {
+        nmea_field_char(p, c);
+        }
+      return nmea_none;
+    case 2:
+      p->check = nmea_hex(c);
+      p->state = (p->check == 0xFF) ? 0 : 3;
+      return nmea_none;
+    case 3: {
+      uint8_t low = nmea_hex(c);
+      p->state = 0;
+      if (low == 0xFF || (uint8_t)((p->check << 4) | low) != p->sum) {
+        p->bad = p->bad + 1;
+        return nmea_none;
+        }
+      p->good = p->good + 1;
+      if (p->work.type == nmea_none) {                                          //good sentence but not one we use
+        return nmea_none;
+        }
+      if (p->work.utc_valid) {                                                  //hhmmss.sss x1000 to ms of the day
+        uint32_t t = p->work.utc_ms;
+        p->work.utc_ms = ((t / 10000000) * 3600 + ((t / 100000) % 100) * 60 + (t / 1000) % 100) * 1000 + t % 1000;
+        }
+      p->fix = p->work;
+      return p->fix.type;
+      }
+    }
+  return nmea_none;
+}
+int32_t nmea_mph_q16(const gps_fix * fix) {                                       //knots x1000 to mph x65536 (x1.1508)
+  int32_t mknots = fix->speed_valid ? fix->speed_mknots : 0;
+  if (mknots < 0) {
+    mknots = 0;
+    }
+  int32_t mph_q16 = (int32_t)(((int64_t)mknots * 754189) / 10000);
+  if (mph_q16 < 32768) {                                                            //display 0 if less than .5 mph
+    mph_q16 = 0;
+    }
+  return mph_q16;
+}
+static uint32_t ubx_u32(const uint8_t * b) {                                        //little endian 32 bit field
+  return (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+}
+bool ubx_feed(ubx_parser * p, uint8_t c) {                                          //one UBX byte, true when a good NAV-PVT frame ends
+  switch (p->state) {
+    case 0:                                                                         //sync 1
+      if (c == 0xB5) p->state = 1;
+      break;
+    case 1:                                                                         //sync 2
+      p->state = (c == 0x62) ? 2 : ((c == 0xB5) ? 1 : 0);
+      break;
+    case 2:                                                                         //class
+      p->msg_class = c;
+      p->ck_a = c;
+      p->ck_b = c;
+      p->state = 3;
+      break;
+    case 3:                                                                         //id
+      p->msg_id = c;
+      p->ck_a += c; p->ck_b += p->ck_a;
+      p->state = 4;
+      break;
+    case 4:                                                                         //length low byte
+      p->len = c;
+      p->ck_a += c; p->ck_b += p->ck_a;
+      p->state = 5;
+      break;
+    case 5:                                                                         //length high byte
+      p->len |= (uint16_t)c << 8;
+      p->ck_a += c; p->ck_b += p->ck_a;
+      p->pos = 0;
+      p->state = (p->len == 0) ? 7 : 6;
+      if (p->len > 512) {                                                           //not a real frame
+        p->state = 0;
+        }
+      break;
+    case 6:                                                                         //payload, only NAV-PVT is kept
+      if (p->pos < ubx_nav_pvt_len) {
+        p->payload[p->pos] = c;
+        }
+      p->pos = p->pos + 1;
+      p->ck_a += c; p->ck_b += p->ck_a;
+      if (p->pos >= p->len) {
+        p->state = 7;
+        }
+      break;
+    case 7:                                                                         //checksum a
+      p->state = (c == p->ck_a) ? 8 : 0;
+      if (p->state == 0) {
+        p->bad = p->bad + 1;
+        }
+      break;
+    case 8: {                                                                       //checksum b, frame is complete
+      p->state = 0;
+      if (c != p->ck_b) {
+        p->bad = p->bad + 1;
+        break;
+        }
+      if (p->msg_class != 0x01 || p->msg_id != 0x07 || p->len != ubx_nav_pvt_len) {
+        break;                                                                      //not NAV-PVT
+        }
+      p->good = p->good + 1;
+      uint8_t fix_type = p->payload[20];                                            //2 = 2D, 3 = 3D
+      bool fix_ok = (p->payload[21] & 0x01) != 0;                                   //gnssFixOK flag
+      int32_t g_speed = (int32_t)ubx_u32(&p->payload[60]);                          //ground speed mm/s
+      uint32_t s_acc = ubx_u32(&p->payload[68]);                                    //speed accuracy mm/s
+      if (g_speed < 0) {
+        g_speed = 0;
+        }
+      p->mph_q16 = (int32_t)(((int64_t)g_speed * 235929600LL) / 1609344);          //mm/s to mph x65536
+      if (p->mph_q16 < 32768) {                                                     //display 0 if less than .5 mph
+        p->mph_q16 = 0;
+        }
+      p->locked = fix_ok && fix_type >= 2 && s_acc <= ubx_sacc_max;                 //speed accuracy decides if speed is shown
+      return true;
+      }
+    default:                                                                        //not a state, start over
+      p->state = 0;
+      break;
+    }
+  return false;
+}
+uint16_t ubx_frame(uint8_t * out, uint8_t msg_class, uint8_t msg_id, const uint8_t * payload, uint16_t len) {   //sync, header, payload and checksum
+  out[0] = 0xB5;
+  out[1] = 0x62;
+  out[2] = msg_class;
+  out[3] = msg_id;
+  out[4] = len & 0xFF;
+  out[5] = len >> 8;
+  for (uint16_t n = 0; n < len; n++) {
+    out[6 + n] = payload[n];
+    }
+  uint8_t ck_a = 0, ck_b = 0;
+  for (uint16_t n = 2; n < len + 6; n++) {
+    ck_a += out[n]; ck_b += ck_a;
+    }
+  out[len + 6] = ck_a;
+  out[len + 7] = ck_b;
+  return len + 8;
+}
@@ -0,0 +1,78 @@
+/**********************
+    gps parsers, NMEA sentences and u-blox UBX NAV-PVT frames, fed one character at a time.
+    No Arduino or esp32 calls so the native env and the unit tests build it as is.
+ **********************/
+#ifndef GPS_PARSE_H
+#define GPS_PARSE_H
+
+#include <stdint.h>
+
+/**********************
+    NMEA gps parser
+    reads one character at a time, nothing is copied. Fields are decoded as they
+    arrive and only kept if the *hh checksum is good. Numbers are fixed point x1000.
+ **********************/
+#define nmea_none 0                                //sentence types returned by nmea_feed()
+#define nmea_rmc 1                                 //recommended minimum: time, status, speed, course
+#define nmea_gga 2                                 //fix data: time, fix quality
+#define nmea_vtg 3                                 //course and speed
+#define nmea_max_len 82                            //longest legal sentence, longer ones are dropped
+#define nmea_no_point 0xFF                         //no decimal point seen in this field yet
+struct gps_fix {                                   //last good sentence
+  uint8_t type;                                    //nmea_rmc, nmea_gga or nmea_vtg
+  bool valid;                                      //RMC status A, GGA quality above 0, VTG mode not N
+  bool speed_valid;                                //speed field was present
+  int32_t speed_mknots;                            //speed over ground, knots x1000
+  bool course_valid;
+  int32_t course_mdeg;                             //course over ground, degrees x1000
+  bool utc_valid;
+  uint32_t utc_ms;                                 //UTC time of day in ms
+  uint8_t quality;                                 //GGA fix quality
+};
+struct nmea_parser {
+  uint8_t state;                                   //0 = wait for '$', 1 = sentence, 2 and 3 = checksum digits
+  uint8_t sum;                                     //running xor of the sentence
+  uint8_t check;                                   //checksum sent with the sentence
+  uint8_t len;                                     //characters in this sentence
+  uint8_t field;                                   //field number, 0 = address ("GPRMC")
+  char id[6];                                      //address field
+  uint8_t id_len;
+  int32_t value;                                   //number in this field x1000 once the field ends
+  uint8_t decimals;                                //digits after the decimal point, nmea_no_point if none yet
+  bool digits;                                     //field had at least one digit
+  bool bad_number;                                 //field is not a number we can hold
+  char letter;                                     //first character of the field
+  gps_fix work;                                    //fields of the sentence being read
+  gps_fix fix;                                     //fields of the last sentence with a good checksum
+  uint32_t good;                                   //sentences with a good checksum
+  uint32_t bad;                                    //sentences with a bad checksum
+};
+
+uint8_t nmea_feed(nmea_parser * p, char c);        //feed one character, returns sentence type when a good sentence ends
+int32_t nmea_mph_q16(const gps_fix * fix);         //speed of a sentence in Q16 mph, 0 under .5 mph or without speed
+
+/**********************
+    u-blox UBX parser (speed_input 2)
+    frame: 0xB5 0x62 class id length(2) payload checksum(2), checksum is 8 bit fletcher over class to payload.
+    only NAV-PVT (class 0x01 id 0x07) is used.
+ **********************/
+#define ubx_nav_pvt_len 92           //NAV-PVT payload length
+#define ubx_sacc_max 300             //u-blox speed accuracy needed to show speed (mm/s), readout shows --- above this
+struct ubx_parser {
+  uint8_t state;                                   //position in the frame
+  uint8_t msg_class;
+  uint8_t msg_id;
+  uint16_t len;                                    //payload length
+  uint16_t pos;                                    //payload bytes read
+  uint8_t ck_a, ck_b;                              //running checksum
+  uint8_t payload[ubx_nav_pvt_len];
+  uint32_t good;                                   //NAV-PVT frames with a good checksum
+  uint32_t bad;                                    //frames with a bad checksum
+  int32_t mph_q16;                                 //ground speed of the last NAV-PVT, 0 under .5 mph
+  bool locked;                                     //fix ok, 2D or 3D and speed accuracy within ubx_sacc_max
+};
+
+bool ubx_feed(ubx_parser * p, uint8_t c);          //feed one byte, returns true when a good NAV-PVT frame ends
+uint16_t ubx_frame(uint8_t * out, uint8_t msg_class, uint8_t msg_id, const uint8_t * payload, uint16_t len);   //build a frame in out (len + 8 bytes), returns its length
+
+#endif
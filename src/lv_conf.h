@@ -71,8 +71,11 @@ typedef int16_t lv_coord_t;
 /* 1: use custom malloc/free, 0: use the built-in `lv_mem_alloc` and `lv_mem_free` */
 #define LV_MEM_CUSTOM      0
 #if LV_MEM_CUSTOM == 0
-/* Size of the memory used by `lv_mem_alloc` in bytes (>= 2kB)*/
+/* Size of the memory used by `lv_mem_alloc` in bytes (>= 2kB)
+ * (the native env sets a bigger one, pointers are 8 bytes there)*/
+#  ifndef LV_MEM_SIZE
 #  define LV_MEM_SIZE    (32U * 1024U)
+#  endif
 
 /* Complier prefix for a big array declaration */
 #  define LV_MEM_ATTR
@@ -83,12 +86,21 @@ typedef int16_t lv_coord_t;
 
 /* Automatically defrag. on free. Defrag. means joining the adjacent free cells. */
 #  define LV_MEM_AUTO_DEFRAG  1
+
+/* Use a two level segregated fit (TLSF) allocator: O(1) malloc/free and no defragmentation needed */
+#  define LV_MEM_TLSF  1
 #else       /*LV_MEM_CUSTOM*/
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
 #  define LV_MEM_CUSTOM_ALLOC   malloc       /*Wrapper to malloc*/
 #  define LV_MEM_CUSTOM_FREE    free         /*Wrapper to free*/
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: `lv_mem_set_trace_cb()` reports every allocation, free and reallocation (to record and replay them).
+ * The native env turns it on for the heap replays of test/mem */
+#ifndef LV_MEM_TRACE
+#define LV_MEM_TRACE 0
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -138,6 +150,21 @@ typedef void * lv_anim_user_data_t;
 /* 1: Enable shadow drawing*/
 #define LV_USE_SHADOW           1
 
+/* Number of anti-aliased corner masks of rounded rectangles to keep (per radius and border width).
+ * Corners with a cached mask are drawn by blending the mask instead of calculating the circle.
+ * 0: no cache*/
+#define LV_DRAW_CORNER_CACHE_SIZE   8
+
+/* Bytes the cached corner masks may use from the LVGL heap together.
+ * The least recently used masks are freed to make room, a mask bigger than this is not cached.*/
+#define LV_DRAW_CORNER_CACHE_MEM    (1U * 1024U)
+
+/* Cache the calculated shadow profiles (per shadow type, radius, shadow width and opacity).
+ * A shadow with a cached profile is drawn by blending the profile's rows.
+ * Size of the cache in bytes from the LVGL heap (0: no cache, calculate on every draw).
+ * The least recently used profiles are freed when it's full.*/
+#define LV_DRAW_SHADOW_CACHE_SIZE   (2U * 1024U)
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
 #if LV_USE_GROUP
@@ -331,6 +358,15 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
  * but with > 10,000 characters if you see issues probably you need to enable it.*/
 #define LV_FONT_FMT_TXT_LARGE   0
 
+/* Look up the glyph ids of printable ASCII letters in a table and remember recent kerning pairs.
+ * The tables (about 400 bytes per font) are allocated from the LVGL heap the first time a font is used.*/
+#define LV_FONT_FMT_TXT_CACHE   1
+
+/* Cache the decompressed glyphs of compressed fonts.
+ * Size of the cache in bytes from the LVGL heap (0: no cache, decompress on every draw).
+ * The least recently used glyphs are freed when it's full.*/
+#define LV_FONT_GLYPH_CACHE_SIZE    (4U * 1024U)
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
@@ -488,6 +524,12 @@ typedef void * lv_obj_user_data_t;
 
 /*Store extra some info in labels (12 bytes) to speed up drawing of very long texts*/
 #  define LV_LABEL_LONG_TXT_HINT          0
+
+/*Invalidate only the letters which changed when a new single line text is set*/
+#  define LV_LABEL_DIFF_INV               1
+
+/*Longest text (in letters) compared letter by letter*/
+#  define LV_LABEL_DIFF_MAX               16
 #endif
 
 /*LED (dependencies: -)*/
@@ -107,6 +107,11 @@
 #ifndef LV_MEM_AUTO_DEFRAG
 #  define LV_MEM_AUTO_DEFRAG  1
 #endif
+
+/* Use a two level segregated fit (TLSF) allocator: O(1) malloc/free and no defragmentation needed */
+#ifndef LV_MEM_TLSF
+#  define LV_MEM_TLSF  0
+#endif
 #else       /*LV_MEM_CUSTOM*/
 #ifndef LV_MEM_CUSTOM_INCLUDE
 #  define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
@@ -119,6 +124,11 @@
 #endif
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: `lv_mem_set_trace_cb()` reports every allocation, free and reallocation (to record and replay them)*/
+#ifndef LV_MEM_TRACE
+#define LV_MEM_TRACE 0
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -189,6 +199,27 @@
 #define LV_USE_SHADOW           1
 #endif
 
+/* Number of anti-aliased corner masks of rounded rectangles to keep (per radius and border width).
+ * Corners with a cached mask are drawn by blending the mask instead of calculating the circle.
+ * 0: no cache*/
+#ifndef LV_DRAW_CORNER_CACHE_SIZE
+#define LV_DRAW_CORNER_CACHE_SIZE   0
+#endif
+
+/* Bytes the cached corner masks may use from the LVGL heap together.
+ * The least recently used masks are freed to make room, a mask bigger than this is not cached.*/
+#ifndef LV_DRAW_CORNER_CACHE_MEM
+#define LV_DRAW_CORNER_CACHE_MEM    (1U * 1024U)
+#endif
+
+/* Cache the calculated shadow profiles (per shadow type, radius, shadow width and opacity).
+ * A shadow with a cached profile is drawn by blending the profile's rows.
+ * Size of the cache in bytes from the LVGL heap (0: no cache, calculate on every draw).
+ * The least recently used profiles are freed when it's full.*/
+#ifndef LV_DRAW_SHADOW_CACHE_SIZE
+#define LV_DRAW_SHADOW_CACHE_SIZE   0
+#endif
+
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #ifndef LV_USE_GROUP
 #define LV_USE_GROUP            1
@@ -463,6 +494,18 @@
 #define LV_FONT_FMT_TXT_LARGE   0
 #endif
 
+/* Look up the glyph ids of printable ASCII letters in a table and remember recent kerning pairs.
+ * The tables are allocated from the LVGL heap the first time a font is used.*/
+#ifndef LV_FONT_FMT_TXT_CACHE
+#define LV_FONT_FMT_TXT_CACHE   0
+#endif
+
+/* Cache the decompressed glyphs of compressed fonts.
+ * Size of the cache in bytes from the LVGL heap (0: no cache, decompress on every draw)*/
+#ifndef LV_FONT_GLYPH_CACHE_SIZE
+#define LV_FONT_GLYPH_CACHE_SIZE    0
+#endif
+
 /* Set the pixel order of the display.
  * Important only if "subpx fonts" are used.
  * With "normal" font it doesn't matter.
@@ -696,6 +739,16 @@
 #ifndef LV_LABEL_LONG_TXT_HINT
 #  define LV_LABEL_LONG_TXT_HINT          0
 #endif
+
+/*Invalidate only the letters which changed when a new single line text is set*/
+#ifndef LV_LABEL_DIFF_INV
+#  define LV_LABEL_DIFF_INV               0
+#endif
+
+/*Longest text (in letters) compared letter by letter*/
+#ifndef LV_LABEL_DIFF_MAX
+#  define LV_LABEL_DIFF_MAX               16
+#endif
 #endif
 
 /*LED (dependencies: -)*/
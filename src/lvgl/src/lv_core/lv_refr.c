@@ -46,6 +46,8 @@ static void lv_refr_vdb_flush(void);
  *  STATIC VARIABLES
  **********************/
 static uint32_t px_num;
+static uint32_t obj_visit_cnt; /*Objects visited while the invalid areas were redrawn*/
+static uint16_t area_cnt;      /*Areas redrawn in the last refresh (after joining)*/
 static lv_disp_t * disp_refr; /*Display being refreshed*/
 
 /**********************
@@ -143,6 +145,28 @@ lv_disp_t * lv_refr_get_disp_refreshing(void)
     return disp_refr;
 }
 
+/**
+ * Get the number of objects visited during the last refresh (searching the top object and drawing).
+ * Hidden objects are counted too because they are still checked.
+ * Can be read in the display driver's `monitor_cb`.
+ * @return number of object visits
+ */
+uint32_t lv_refr_get_obj_visits(void)
+{
+    return obj_visit_cnt;
+}
+
+/**
+ * Get the number of areas redrawn during the last refresh.
+ * Areas joined into an other one are not counted.
+ * Can be read in the display driver's `monitor_cb`.
+ * @return number of redrawn areas
+ */
+uint16_t lv_refr_get_area_cnt(void)
+{
+    return area_cnt;
+}
+
 /**
  * Set the display which is being refreshed.
  * It shouldn1t be used directly by the user.
@@ -165,6 +189,7 @@ void lv_disp_refr_task(lv_task_t * task)
     uint32_t start = lv_tick_get();
 
     disp_refr = task->user_data;
+    obj_visit_cnt = 0;
 
     lv_refr_join_area();
 
@@ -268,7 +293,8 @@ static void lv_refr_join_area(void)
  */
 static void lv_refr_areas(void)
 {
-    px_num = 0;
+    px_num   = 0;
+    area_cnt = 0;
     uint32_t i;
 
     for(i = 0; i < disp_refr->inv_p; i++) {
@@ -276,6 +302,7 @@ static void lv_refr_areas(void)
         if(disp_refr->inv_area_joined[i] == 0) {
 
             lv_refr_area(&disp_refr->inv_areas[i]);
+            area_cnt++;
 
             if(disp_refr->driver.monitor_cb) px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
         }
@@ -416,6 +443,7 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 {
     lv_obj_t * found_p = NULL;
+    obj_visit_cnt++;
 
     /*If this object is fully cover the draw area check the children too */
     if(lv_area_is_in(area_p, &obj->coords) && obj->hidden == 0) {
@@ -493,6 +521,8 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
  */
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 {
+    obj_visit_cnt++;
+
     /*Do not refresh hidden objects*/
     if(obj->hidden != 0) return;
 
@@ -68,6 +68,22 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
  */
 lv_disp_t * lv_refr_get_disp_refreshing(void);
 
+/**
+ * Get the number of objects visited during the last refresh (searching the top object and drawing).
+ * Hidden objects are counted too because they are still checked.
+ * Can be read in the display driver's `monitor_cb`.
+ * @return number of object visits
+ */
+uint32_t lv_refr_get_obj_visits(void);
+
+/**
+ * Get the number of areas redrawn during the last refresh.
+ * Areas joined into an other one are not counted.
+ * Can be read in the display driver's `monitor_cb`.
+ * @return number of redrawn areas
+ */
+uint16_t lv_refr_get_area_cnt(void);
+
 /**
  * Set the display which is being refreshed.
  * It shouldn1t be used directly by the user.
@@ -34,6 +34,15 @@
 #define LV_ATTRIBUTE_MEM_ALIGN
 #endif
 
+/*With RGB565 fill and blend two pixels at once in a 32 bit word.
+ *A channel of both pixels is mixed with one multiply because even 63 * 255 fits in a 16 bit half.
+ *The words are read and written with `memcpy` so `lv_color_t` buffers are never accessed as `uint32_t`*/
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+#define SW_565X2 1
+#else
+#define SW_565X2 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -44,6 +53,14 @@
 static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
 static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_t * fill_area, lv_color_t color,
                           lv_opa_t opa);
+static inline void sw_fill_row(lv_color_t * dest, lv_color_t color, uint32_t length);
+
+#if SW_565X2
+static inline uint32_t load_565x2(const lv_color_t * src);
+static inline void store_565x2(lv_color_t * dest, uint32_t px2);
+static inline uint32_t mix_565x2(uint32_t fg, uint32_t bg, lv_opa_t mix);
+static void sw_blend_row_565x2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa);
+#endif
 
 #if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
 static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa, lv_color_t fg_color, lv_opa_t fg_opa);
@@ -511,8 +528,9 @@ void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint
     scr_transp = disp->driver.screen_transp;
 #endif
 
-    /*The simplest case just copy the pixels into the VDB*/
-    if(chroma_key == false && alpha_byte == false && opa == LV_OPA_COVER && recolor_opa == LV_OPA_TRANSP) {
+    /*The simplest case just copy the pixels into the VDB (or blend them two at a time with RGB565)*/
+    if(chroma_key == false && alpha_byte == false && (opa == LV_OPA_COVER || SW_565X2) &&
+       recolor_opa == LV_OPA_TRANSP) {
 
         /*Use the custom VDB write function is exists*/
         if(disp->driver.set_px_cb) {
@@ -629,6 +647,80 @@ void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint
     }
 }
 
+/**
+ * Blend a color to the Virtual Display Buffer through an opacity map (e.g. an anti-aliased corner)
+ * @param cords_p coordinates of the map
+ * @param mask_p the map will drawn only on this area  (truncated to VDB area)
+ * @param map_p opacity of the pixels, `lv_area_get_width(cords_p)` bytes in a row
+ * @param mirror_x true: use the rows of the map from right to left
+ * @param mirror_y true: use the rows of the map from bottom to top
+ * @param color color to blend
+ * @param opa opacity of the map (0..255)
+ */
+void lv_draw_opa_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_opa_t * map_p, bool mirror_x,
+                     bool mirror_y, lv_color_t color, lv_opa_t opa)
+{
+    if(opa < LV_OPA_MIN) return;
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    lv_area_t masked_a;
+    if(lv_area_intersect(&masked_a, cords_p, mask_p) == false) return;
+
+    lv_disp_t * disp    = lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    lv_coord_t map_w     = lv_area_get_width(cords_p);
+    lv_coord_t map_h     = lv_area_get_height(cords_p);
+    lv_coord_t vdb_width = lv_area_get_width(&vdb->area);
+    lv_color_t * vdb_buf_tmp = vdb->buf_act;
+    vdb_buf_tmp += (uint32_t)vdb_width * (masked_a.y1 - vdb->area.y1) + (masked_a.x1 - vdb->area.x1);
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = disp->driver.screen_transp;
+#endif
+
+    /*The first column of the map to use and the direction to step on the map*/
+    lv_coord_t map_x1  = masked_a.x1 - cords_p->x1;
+    int8_t map_step_x = 1;
+    if(mirror_x) {
+        map_x1     = map_w - 1 - map_x1;
+        map_step_x = -1;
+    }
+
+    lv_coord_t w = lv_area_get_width(&masked_a);
+    lv_coord_t row;
+    lv_coord_t col;
+    for(row = masked_a.y1; row <= masked_a.y2; row++) {
+        lv_coord_t map_y = row - cords_p->y1;
+        if(mirror_y) map_y = map_h - 1 - map_y;
+        const lv_opa_t * map_px = &map_p[(uint32_t)map_y * map_w + map_x1];
+
+        for(col = 0; col < w; col++) {
+            lv_opa_t px_opa = *map_px;
+            map_px += map_step_x;
+
+            if(opa != LV_OPA_COVER) px_opa = (uint16_t)((uint16_t)px_opa * opa) >> 8;
+            if(px_opa < LV_OPA_MIN) continue;
+
+            if(disp->driver.set_px_cb) {
+                disp->driver.set_px_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width,
+                                       masked_a.x1 + col - vdb->area.x1, row - vdb->area.y1, color, px_opa);
+            } else if(px_opa > LV_OPA_MAX) {
+                vdb_buf_tmp[col] = color;
+            } else if(scr_transp == false) {
+                vdb_buf_tmp[col] = lv_color_mix(color, vdb_buf_tmp[col], px_opa);
+            } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                vdb_buf_tmp[col] = color_mix_2_alpha(vdb_buf_tmp[col], vdb_buf_tmp[col].ch.alpha, color, px_opa);
+#endif
+            }
+        }
+
+        vdb_buf_tmp += vdb_width; /*Next row on the VDB*/
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -645,10 +737,14 @@ static void sw_mem_blend(lv_color_t * dest, const lv_color_t * src, uint32_t len
     if(opa == LV_OPA_COVER) {
         memcpy(dest, src, length * sizeof(lv_color_t));
     } else {
+#if SW_565X2
+        sw_blend_row_565x2(dest, src, length, opa);
+#else
         uint32_t col;
         for(col = 0; col < length; col++) {
             dest[col] = lv_color_mix(src[col], dest[col], opa);
         }
+#endif
     }
 }
 
@@ -679,22 +775,59 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
 
         /*Run simpler function without opacity*/
         if(opa == LV_OPA_COVER) {
-
-            /*Fill the first row with 'color'*/
-            for(col = fill_area->x1; col <= fill_area->x2; col++) {
-                mem[col] = color;
+            uint32_t fill_w = lv_area_get_width(fill_area);
+            for(row = fill_area->y1; row <= fill_area->y2; row++) {
+                sw_fill_row(&mem[fill_area->x1], color, fill_w);
+                mem += mem_width;
             }
+        }
+#if SW_565X2
+        /*Calculate with alpha, two pixels at once*/
+        else {
+            uint32_t fill_w = lv_area_get_width(fill_area);
+            lv_color_t fg_pair[2] = {color, color};
+            uint32_t fg2          = load_565x2(fg_pair);
+            lv_color_t bg_tmp  = LV_COLOR_BLACK;
+            lv_color_t opa_tmp = lv_color_mix(color, bg_tmp, opa);
+            uint32_t bg2       = 0;
+            uint32_t opa2      = mix_565x2(fg2, bg2, opa);
+            for(row = fill_area->y1; row <= fill_area->y2; row++) {
+                lv_color_t * d = &mem[fill_area->x1];
+                uint32_t len   = fill_w;
+
+                /*Align to 4 bytes*/
+                if(((lv_uintptr_t)d & 0x2) && len > 0) {
+                    if(d->full != bg_tmp.full) {
+                        bg_tmp  = *d;
+                        opa_tmp = lv_color_mix(color, bg_tmp, opa);
+                    }
+                    *d = opa_tmp;
+                    d++;
+                    len--;
+                }
 
-            /*Copy the first row to all other rows*/
-            lv_color_t * mem_first = &mem[fill_area->x1];
-            lv_coord_t copy_size   = (fill_area->x2 - fill_area->x1 + 1) * sizeof(lv_color_t);
-            mem += mem_width;
+                /*Recalculate only if the two background pixels changed*/
+                for(; len >= 2; len -= 2) {
+                    uint32_t d2 = load_565x2(d);
+                    if(d2 != bg2) {
+                        bg2  = d2;
+                        opa2 = mix_565x2(fg2, bg2, opa);
+                    }
+                    store_565x2(d, opa2);
+                    d += 2;
+                }
 
-            for(row = fill_area->y1 + 1; row <= fill_area->y2; row++) {
-                memcpy(&mem[fill_area->x1], mem_first, copy_size);
+                if(len) {
+                    if(d->full != bg_tmp.full) {
+                        bg_tmp  = *d;
+                        opa_tmp = lv_color_mix(color, bg_tmp, opa);
+                    }
+                    *d = opa_tmp;
+                }
                 mem += mem_width;
             }
         }
+#else
         /*Calculate with alpha too*/
         else {
             bool scr_transp = false;
@@ -724,8 +857,119 @@ static void sw_color_fill(lv_color_t * mem, lv_coord_t mem_width, const lv_area_
                 mem += mem_width;
             }
         }
+#endif
+    }
+}
+
+/**
+ * Fill a row of pixels with a color
+ * @param dest the first pixel to fill
+ * @param color fill color
+ * @param length number of pixels
+ */
+static inline void sw_fill_row(lv_color_t * dest, lv_color_t color, uint32_t length)
+{
+#if SW_565X2
+    /*Align to 4 bytes*/
+    if(((lv_uintptr_t)dest & 0x2) && length > 0) {
+        *dest = color;
+        dest++;
+        length--;
+    }
+
+    /*Two pixels with one store, 8 pixels in one iteration*/
+    lv_color_t pair[2] = {color, color};
+    uint32_t c32       = load_565x2(pair);
+    uint32_t words     = length >> 1;
+    for(; words >= 4; words -= 4) {
+        store_565x2(dest, c32);
+        store_565x2(dest + 2, c32);
+        store_565x2(dest + 4, c32);
+        store_565x2(dest + 6, c32);
+        dest += 8;
+    }
+    for(; words > 0; words--) {
+        store_565x2(dest, c32);
+        dest += 2;
+    }
+
+    if(length & 0x1) *dest = color;
+#else
+    uint32_t i;
+    for(i = 0; i < length; i++) {
+        dest[i] = color;
+    }
+#endif
+}
+
+#if SW_565X2
+/**
+ * Read two neighbouring pixels as one word
+ * @param src the first pixel (needn't be 4 byte aligned)
+ * @return the two pixels, in the same order as `store_565x2` writes them
+ */
+static inline uint32_t load_565x2(const lv_color_t * src)
+{
+    uint32_t px2;
+    memcpy(&px2, src, sizeof(px2));
+    return px2;
+}
+
+/**
+ * Write two neighbouring pixels from one word
+ * @param dest the first pixel
+ * @param px2 two pixels from `load_565x2` or `mix_565x2`
+ */
+static inline void store_565x2(lv_color_t * dest, uint32_t px2)
+{
+    memcpy(dest, &px2, sizeof(px2));
+}
+
+/**
+ * Mix two pairs of RGB565 colors. Gives the same result as `lv_color_mix` on both pixels.
+ * @param fg two foreground pixels (each 16 bit half is a pixel)
+ * @param bg two background pixels
+ * @param mix mix ratio of the foreground
+ * @return the two mixed pixels
+ */
+static inline uint32_t mix_565x2(uint32_t fg, uint32_t bg, lv_opa_t mix)
+{
+    uint32_t mix_inv = 255 - mix;
+    uint32_t r       = ((fg >> 11) & 0x001F001F) * mix + ((bg >> 11) & 0x001F001F) * mix_inv;
+    uint32_t g       = ((fg >> 5) & 0x003F003F) * mix + ((bg >> 5) & 0x003F003F) * mix_inv;
+    uint32_t b       = (fg & 0x001F001F) * mix + (bg & 0x001F001F) * mix_inv;
+
+    return (((r >> 8) & 0x001F001F) << 11) | (((g >> 8) & 0x003F003F) << 5) | ((b >> 8) & 0x001F001F);
+}
+
+/**
+ * Blend a row of RGB565 pixels two at a time
+ * @param dest destination pixels
+ * @param src source pixels (may be aligned differently than 'dest')
+ * @param length number of pixels
+ * @param opa opacity of 'src'
+ */
+static void sw_blend_row_565x2(lv_color_t * dest, const lv_color_t * src, uint32_t length, lv_opa_t opa)
+{
+    /*Align the destination to 4 bytes*/
+    if(((lv_uintptr_t)dest & 0x2) && length > 0) {
+        *dest = lv_color_mix(*src, *dest, opa);
+        dest++;
+        src++;
+        length--;
+    }
+
+    for(; length >= 2; length -= 2) {
+        store_565x2(dest, mix_565x2(load_565x2(src), load_565x2(dest), opa));
+        dest += 2;
+        src += 2;
+    }
+
+    if(length) {
+        *dest = lv_color_mix(*src, *dest, opa);
     }
 }
+#endif
 
 #if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
 /**
@@ -71,6 +71,19 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
 void lv_draw_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const uint8_t * map_p, lv_opa_t opa,
                  bool chroma_key, bool alpha_byte, lv_color_t recolor, lv_opa_t recolor_opa);
 
+/**
+ * Blend a color to the Virtual Display Buffer through an opacity map (e.g. an anti-aliased corner)
+ * @param cords_p coordinates of the map
+ * @param mask_p the map will drawn only on this area  (truncated to VDB area)
+ * @param map_p opacity of the pixels, `lv_area_get_width(cords_p)` bytes in a row
+ * @param mirror_x true: use the rows of the map from right to left
+ * @param mirror_y true: use the rows of the map from bottom to top
+ * @param color color to blend
+ * @param opa opacity of the map (0..255)
+ */
+void lv_draw_opa_map(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_opa_t * map_p, bool mirror_x,
+                     bool mirror_y, lv_color_t color, lv_opa_t opa);
+
 /**********************
  *      MACROS
  **********************/
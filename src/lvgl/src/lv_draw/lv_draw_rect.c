@@ -24,9 +24,56 @@
 /*Add extra radius with LV_SHADOW_BOTTOM to cover anti-aliased corners*/
 #define SHADOW_BOTTOM_AA_EXTRA_RADIUS 3
 
+/*Corners with larger radius are not cached. (The mask is (radius + 2)^2 bytes)*/
+#define CORNER_CACHE_MAX_RADIUS 32
+
+/*Bytes of a corner mask with its row parts*/
+#define CORNER_MAP_SIZE(size) ((uint32_t)(size) * (size) + (size) * sizeof(corner_row_t))
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_CORNER_CACHE_SIZE
+/*The parts of a row of a corner mask: transparent, anti-aliased, covered, anti-aliased and transparent again*/
+typedef struct
+{
+    uint8_t aa1;  /*First not transparent pixel*/
+    uint8_t full; /*First covered pixel*/
+    uint8_t aa2;  /*First not covered pixel after `full`*/
+    uint8_t end;  /*Last not transparent pixel + 1*/
+} corner_row_t;
+
+/*An opacity mask of the top left corner of a rounded rectangle*/
+typedef struct
+{
+    lv_opa_t * map;  /*`size` x `size` opacity values and `size` `corner_row_t`. NULL: not created yet or freed*/
+    uint32_t life;   /*When it was used last time. The least recently used entry is replaced*/
+    uint16_t radius; /*The radius after `lv_draw_cont_radius_corr`*/
+    int16_t bwidth;  /*Border width or -1 for the body*/
+    uint8_t aa;      /*Anti-aliased or not*/
+    uint8_t size;    /*`radius + aa + 1`*/
+} corner_cache_entry_t;
+#endif
+
+#if LV_USE_SHADOW && LV_DRAW_SHADOW_CACHE_SIZE
+/*A calculated shadow profile. The profile is allocated right after it.*/
+typedef struct _shadow_cache_entry_t
+{
+    struct _shadow_cache_entry_t * next; /*The next less recently used profile*/
+    uint32_t size;                       /*Size of the profile in bytes*/
+    lv_coord_t radius;                   /*Radius of the shadow (with the anti-aliasing extra)*/
+    lv_coord_t swidth;                   /*Width of the shadow (with the anti-aliasing extra)*/
+    lv_opa_t opa;
+    uint8_t type;                        /*LV_SHADOW_FULL or LV_SHADOW_BOTTOM*/
+} shadow_cache_entry_t;
+
+/*A row of a full shadow's corner in the profile. `cnt` opacity values follow it (padded to even)*/
+typedef struct
+{
+    lv_coord_t x; /*`curve_x` of the row*/
+    uint16_t cnt; /*Number of opacity values*/
+} shadow_row_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -49,9 +96,39 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
                                   lv_opa_t opa_scale);
 static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                          const lv_opa_t * map);
+static void lv_draw_shadow_full_buf(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t ** curve_x,
+                                    uint32_t ** line_1d_blur, lv_opa_t ** line_2d_blur);
+static uint16_t lv_draw_shadow_full_line(int16_t line, lv_coord_t radius, lv_coord_t swidth, const lv_coord_t * curve_x,
+                                         const uint32_t * line_1d_blur, lv_opa_t * line_2d_blur);
+static void lv_draw_shadow_bottom_buf(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t ** curve_x,
+                                      lv_opa_t ** line_1d_blur);
+static lv_opa_t lv_draw_shadow_bottom_px_opa(const lv_opa_t * line_1d_blur, int16_t diff, uint16_t d);
+#if LV_DRAW_SHADOW_CACHE_SIZE
+static void lv_draw_shadow_full_cached(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                                       lv_coord_t radius, lv_coord_t swidth, const uint8_t * prof);
+static void lv_draw_shadow_bottom_cached(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                                         lv_coord_t radius, lv_coord_t swidth, const uint8_t * prof);
+static shadow_cache_entry_t * shadow_cache_add_full(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa);
+static shadow_cache_entry_t * shadow_cache_add_bottom(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa);
+static shadow_cache_entry_t * shadow_cache_get(uint8_t type, lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa);
+static shadow_cache_entry_t * shadow_cache_add(uint8_t type, lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa,
+                                               uint32_t size);
+#endif
 #endif
 
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h);
+static void corner_fill(const lv_area_t * area, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+static void corner_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
+
+#if LV_DRAW_CORNER_CACHE_SIZE
+static bool lv_draw_rect_main_corner_cached(const lv_area_t * coords, const lv_area_t * mask,
+                                            const lv_style_t * style, uint16_t radius, lv_opa_t opa);
+static bool lv_draw_rect_border_corner_cached(const lv_area_t * coords, const lv_area_t * mask,
+                                              const lv_style_t * style, uint16_t radius, lv_opa_t opa);
+static void corner_draw_row(const corner_cache_entry_t * e, lv_coord_t r, lv_coord_t x1, lv_coord_t x2, lv_coord_t y,
+                            const lv_area_t * mask, lv_color_t color, lv_opa_t opa, bool body);
+static const corner_cache_entry_t * corner_cache_get(uint16_t radius, int16_t bwidth, const lv_style_t * style);
+#endif
 
 #if LV_ANTIALIAS
 static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_t opa);
@@ -60,6 +137,22 @@ static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_DRAW_CORNER_CACHE_SIZE
+static corner_cache_entry_t corner_cache[LV_DRAW_CORNER_CACHE_SIZE];
+static uint32_t corner_cache_life;
+static uint32_t corner_cache_used; /*Bytes used by the cached masks*/
+
+/*While a mask is created the corners are drawn to this opacity map instead of the VDB*/
+static lv_opa_t * corner_gen_map;
+static lv_coord_t corner_gen_w;
+#endif
+
+#if LV_USE_SHADOW && LV_DRAW_SHADOW_CACHE_SIZE
+static shadow_cache_entry_t * shadow_cache_head; /*The most recently used profile*/
+static uint32_t shadow_cache_used;               /*Bytes used by the cached profiles*/
+static uint32_t shadow_cache_hit;
+static uint32_t shadow_cache_miss;
+#endif
 
 /**********************
  *      MACROS
@@ -108,6 +201,22 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
     }
 }
 
+/**
+ * Get the hit and miss counters of the shadow profile cache
+ * @param hit store the number of shadows drawn from a cached profile here (can be NULL)
+ * @param miss store the number of shadow profiles calculated here (can be NULL)
+ */
+void lv_draw_shadow_cache_get_stat(uint32_t * hit, uint32_t * miss)
+{
+#if LV_USE_SHADOW && LV_DRAW_SHADOW_CACHE_SIZE
+    if(hit) *hit = shadow_cache_hit;
+    if(miss) *miss = shadow_cache_miss;
+#else
+    if(hit) *hit = 0;
+    if(miss) *miss = 0;
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -207,6 +316,10 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+#if LV_DRAW_CORNER_CACHE_SIZE
+    if(corner_gen_map == NULL && lv_draw_rect_main_corner_cached(coords, mask, style, radius, opa)) return;
+#endif
+
     lv_point_t lt_origo; /*Left  Top    origo*/
     lv_point_t lb_origo; /*Left  Bottom origo*/
     lv_point_t rt_origo; /*Right Top    origo*/
@@ -282,27 +395,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                         aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
                     }
 
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                              aa_color_hor_bottom, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                              aa_color_hor_bottom, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                              aa_color_hor_top, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                              aa_color_hor_top, aa_opa);
 
                     mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
                     aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                              aa_color_ver, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                              aa_color_ver, aa_opa);
 
                     aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                              aa_color_ver, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                              aa_color_ver, aa_opa);
                 }
 
                 out_x_last      = cir.x;
@@ -333,7 +446,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&edge_top_area, mask, act_color, opa);
+            corner_fill(&edge_top_area, mask, act_color, opa);
         }
 
         if(mid_top_refr != 0) {
@@ -343,7 +456,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&mid_top_area, mask, act_color, opa);
+            corner_fill(&mid_top_area, mask, act_color, opa);
         }
 
         if(mid_bot_refr != 0) {
@@ -353,7 +466,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+            corner_fill(&mid_bot_area, mask, act_color, opa);
         }
 
         if(edge_bot_refr != 0) {
@@ -364,7 +477,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                 mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
                 act_color = lv_color_mix(mcolor, gcolor, mix);
             }
-            lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+            corner_fill(&edge_bot_area, mask, act_color, opa);
         }
 
         /*Save the current coordinates*/
@@ -389,7 +502,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
         act_color = lv_color_mix(mcolor, gcolor, mix);
     }
-    lv_draw_fill(&edge_top_area, mask, act_color, opa);
+    corner_fill(&edge_top_area, mask, act_color, opa);
 
     if(edge_top_area.y1 != mid_top_area.y1) {
 
@@ -399,7 +512,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
             act_color = lv_color_mix(mcolor, gcolor, mix);
         }
-        lv_draw_fill(&mid_top_area, mask, act_color, opa);
+        corner_fill(&mid_top_area, mask, act_color, opa);
     }
 
     if(mcolor.full == gcolor.full)
@@ -408,7 +521,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
         act_color = lv_color_mix(mcolor, gcolor, mix);
     }
-    lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+    corner_fill(&mid_bot_area, mask, act_color, opa);
 
     if(edge_bot_area.y1 != mid_bot_area.y1) {
 
@@ -418,7 +531,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
             act_color = lv_color_mix(mcolor, gcolor, mix);
         }
-        lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+        corner_fill(&edge_bot_area, mask, act_color, opa);
     }
 
 #if LV_ANTIALIAS
@@ -428,11 +541,11 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         edge_top_area.x2 = coords->x2 - radius - 2;
         edge_top_area.y1 = coords->y1;
         edge_top_area.y2 = coords->y1;
-        lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        corner_fill(&edge_top_area, mask, style->body.main_color, opa);
 
         edge_top_area.y1 = coords->y2;
         edge_top_area.y2 = coords->y2;
-        lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        corner_fill(&edge_top_area, mask, style->body.grad_color, opa);
 
         /*Last parts of the anti-alias*/
         out_y_seg_end       = cir.y;
@@ -449,27 +562,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_coord_t i;
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                      aa_color_hor_top, aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                      aa_color_hor_top, aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                      aa_color_hor_bottom, aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                      aa_color_hor_bottom, aa_opa);
 
             mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
             aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
+                      aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
+                      aa_opa);
 
             aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
+                      aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
+                      aa_opa);
         }
 
         /*In some cases the last pixel is not drawn*/
@@ -482,14 +595,14 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             aa_color_hor_bottom = lv_color_mix(mcolor, gcolor, mix);
 
             lv_opa_t aa_opa = opa >> 1;
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
+            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
+                      aa_opa);
+            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
+                      aa_opa);
+            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
+                      aa_opa);
+            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
+                      aa_opa);
         }
     }
 #endif
@@ -724,6 +837,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
 
     radius = lv_draw_cont_radius_corr(radius, width, height);
 
+#if LV_DRAW_CORNER_CACHE_SIZE
+    if(corner_gen_map == NULL && part == LV_BORDER_FULL &&
+       lv_draw_rect_border_corner_cached(coords, mask, style, radius, opa)) {
+        return;
+    }
+#endif
+
     lv_point_t lt_origo; /*Left  Top    origo*/
     lv_point_t lb_origo; /*Left  Bottom origo*/
     lv_point_t rt_origo; /*Right Top    origo*/
@@ -804,31 +924,31 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
                     }
                 }
 
@@ -857,45 +977,45 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                        lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                        lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
-                                   style->body.border.color, aa_opa);
+                        corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
+                                  style->body.border.color, aa_opa);
                     }
 
                     /*Be sure the pixels on the middle are not drawn twice*/
                     if(LV_CIRC_OCT1_X(aa_p) - 1 != LV_CIRC_OCT2_X(aa_p) + i) {
                         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1,
+                                      mask, style->body.border.color, aa_opa);
                         }
 
                         if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i,
-                                       mask, style->body.border.color, aa_opa);
+                            corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i,
+                                      mask, style->body.border.color, aa_opa);
                         }
                     }
                 }
@@ -912,13 +1032,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT1_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT1_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.x2 = rb_origo.x + LV_CIRC_OCT2_X(cir_out);
             circ_area.y1 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out) - act_w1;
             circ_area.y2 = rb_origo.y + LV_CIRC_OCT2_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the left bottom corner*/
@@ -927,13 +1047,13 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT3_X(cir_out);
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out) - act_w2;
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT3_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             circ_area.x1 = lb_origo.x + LV_CIRC_OCT4_X(cir_out);
             circ_area.x2 = lb_origo.x + LV_CIRC_OCT4_X(cir_out) + act_w1;
             circ_area.y1 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
             circ_area.y2 = lb_origo.y + LV_CIRC_OCT4_Y(cir_out);
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the left top corner*/
@@ -944,14 +1064,14 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = lt_origo.x + LV_CIRC_OCT5_X(cir_out) + act_w2;
                 circ_area.y1 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
                 circ_area.y2 = lt_origo.y + LV_CIRC_OCT5_Y(cir_out);
-                lv_draw_fill(&circ_area, mask, color, opa);
+                corner_fill(&circ_area, mask, color, opa);
             }
 
             circ_area.x1 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.x2 = lt_origo.x + LV_CIRC_OCT6_X(cir_out);
             circ_area.y1 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out);
             circ_area.y2 = lt_origo.y + LV_CIRC_OCT6_Y(cir_out) + act_w1;
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
         }
 
         /*Draw the octets to the right top corner*/
@@ -960,7 +1080,7 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             circ_area.x2 = rt_origo.x + LV_CIRC_OCT7_X(cir_out);
             circ_area.y1 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out);
             circ_area.y2 = rt_origo.y + LV_CIRC_OCT7_Y(cir_out) + act_w2;
-            lv_draw_fill(&circ_area, mask, color, opa);
+            corner_fill(&circ_area, mask, color, opa);
 
             /*Don't draw if the lines are common in the middle*/
             if(rb_origo.y + LV_CIRC_OCT1_Y(cir_out) > rt_origo.y + LV_CIRC_OCT8_Y(cir_out)) {
@@ -968,7 +1088,7 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
                 circ_area.x2 = rt_origo.x + LV_CIRC_OCT8_X(cir_out);
                 circ_area.y1 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
                 circ_area.y2 = rt_origo.y + LV_CIRC_OCT8_Y(cir_out);
-                lv_draw_fill(&circ_area, mask, color, opa);
+                corner_fill(&circ_area, mask, color, opa);
             }
         }
         lv_circ_next(&cir_out, &tmp_out);
@@ -994,31 +1114,31 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
             }
         }
 
@@ -1030,23 +1150,23 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
             lv_opa_t aa_opa = opa >> 1;
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask,
+                          style->body.border.color, aa_opa);
             }
         }
 
@@ -1059,44 +1179,44 @@ static void lv_draw_rect_border_corner(const lv_area_t * coords, const lv_area_t
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = lv_draw_aa_get_opa(seg_size, i, opa);
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) - 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) - 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) + 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
-                           style->body.border.color, aa_opa);
+                corner_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) + 1, mask,
+                          style->body.border.color, aa_opa);
             }
 
             if(LV_CIRC_OCT1_X(aa_p) - 1 != LV_CIRC_OCT2_X(aa_p) + i) {
                 if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_RIGHT)) {
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) - 1, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_BOTTOM) && (part & LV_BORDER_LEFT)) {
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) + 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_TOP) && (part & LV_BORDER_LEFT)) {
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) + 1, mask,
+                              style->body.border.color, aa_opa);
                 }
 
                 if((part & LV_BORDER_TOP) && (part & LV_BORDER_RIGHT)) {
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               style->body.border.color, aa_opa);
+                    corner_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) - 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
+                              style->body.border.color, aa_opa);
                 }
             }
         }
@@ -1168,39 +1288,24 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
 
     radius += aa;
 
-    /*Allocate a draw buffer the buffer required to draw the shadow*/
-    int16_t filter_width = 2 * swidth + 1;
-    uint32_t curve_x_size = ((radius + swidth + 1) + 3) & ~0x3; /*Round to 4*/
-    curve_x_size *= sizeof(lv_coord_t);
-    uint32_t line_1d_blur_size = (filter_width + 3) & ~0x3;     /*Round to 4*/
-    line_1d_blur_size *= sizeof(uint32_t);
-    uint32_t line_2d_blur_size = ((radius + swidth + 1) + 3) & ~0x3;     /*Round to 4*/
-    line_2d_blur_size *= sizeof(lv_opa_t);
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
 
-    uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size + line_2d_blur_size);
+#if LV_DRAW_SHADOW_CACHE_SIZE
+    /*Only blend the rows if the profile is cached (or can be cached now)*/
+    shadow_cache_entry_t * e = shadow_cache_get(LV_SHADOW_FULL, radius, swidth, opa);
+    if(e == NULL) e = shadow_cache_add_full(radius, swidth, opa);
+    if(e) {
+        lv_draw_shadow_full_cached(coords, mask, style, radius, swidth, (const uint8_t *)(e + 1));
+        return;
+    }
+#endif
 
-    /*Divide the draw buffer*/
-    lv_coord_t  * curve_x = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
-    uint32_t * line_1d_blur = (uint32_t *)&draw_buf[curve_x_size];
-    lv_opa_t * line_2d_blur = (lv_opa_t *)&draw_buf[curve_x_size + line_1d_blur_size];
+    lv_coord_t * curve_x;
+    uint32_t * line_1d_blur;
+    lv_opa_t * line_2d_blur;
+    lv_draw_shadow_full_buf(radius, swidth, opa, &curve_x, &line_1d_blur, &line_2d_blur);
 
-    memset(curve_x, 0, curve_x_size);
-    lv_point_t circ;
-    lv_coord_t circ_tmp;
-    lv_circ_init(&circ, &circ_tmp, radius);
-    while(lv_circ_cont(&circ)) {
-        curve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
-        curve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
-        lv_circ_next(&circ, &circ_tmp);
-    }
     int16_t line;
-    /*1D Blur horizontally*/
-    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
-    for(line = 0; line < filter_width; line++) {
-        line_1d_blur[line] = (uint32_t)((uint32_t)(filter_width - line) * (opa * 2) << SHADOW_OPA_EXTRA_PRECISION) /
-                             (filter_width * filter_width);
-    }
-
     uint16_t col;
 
     lv_point_t point_rt;
@@ -1222,44 +1327,8 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
 
     ofs_lt.x = coords->x1 + radius + aa;
     ofs_lt.y = coords->y1 + radius + aa;
-    bool line_ready;
     for(line = 0; line <= radius + swidth; line++) { /*Check all rows and make the 1D blur to 2D*/
-        line_ready = false;
-        for(col = 0; col <= radius + swidth; col++) { /*Check all pixels in a 1D blur line (from the origo to last
-                                                         shadow pixel (radius + swidth))*/
-
-            /*Sum the opacities from the lines above and below this 'row'*/
-            int16_t line_rel;
-            uint32_t px_opa_sum = 0;
-            for(line_rel = -swidth; line_rel <= swidth; line_rel++) {
-                /*Get the relative x position of the 'line_rel' to 'line'*/
-                int16_t col_rel;
-                if(line + line_rel < 0) { /*Below the radius, here is the blur of the edge */
-                    col_rel = radius - curve_x[line] - col;
-                } else if(line + line_rel > radius) { /*Above the radius, here won't be more 1D blur*/
-                    break;
-                } else { /*Blur from the curve*/
-                    col_rel = curve_x[line + line_rel] - curve_x[line] - col;
-                }
-
-                /*Add the value of the 1D blur on 'col_rel' position*/
-                if(col_rel < -swidth) { /*Outside of the blurred area. */
-                    if(line_rel == -swidth)
-                        line_ready = true; /*If no data even on the very first line then it wont't
-                                              be anything else in this line*/
-                    break;                 /*Break anyway because only smaller 'col_rel' values will come */
-                } else if(col_rel > swidth)
-                    px_opa_sum += line_1d_blur[0]; /*Inside the not blurred area*/
-                else
-                    px_opa_sum += line_1d_blur[swidth - col_rel]; /*On the 1D blur (+ swidth to align to the center)*/
-            }
-
-            line_2d_blur[col] = px_opa_sum >> SHADOW_OPA_EXTRA_PRECISION;
-            if(line_ready) {
-                col++; /*To make this line to the last one ( drawing will go to '< col')*/
-                break;
-            }
-        }
+        col = lv_draw_shadow_full_line(line, radius, swidth, curve_x, line_1d_blur, line_2d_blur);
 
         /*Flush the line*/
         point_rt.x = curve_x[line] + ofs_rt.x + 1;
@@ -1320,32 +1389,23 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
     radius += aa * SHADOW_BOTTOM_AA_EXTRA_RADIUS;
     swidth += aa;
 
-    uint32_t curve_x_size = ((radius + 1) + 3) & ~0x3; /*Round to 4*/
-    curve_x_size *= sizeof(lv_coord_t);
-    lv_opa_t line_1d_blur_size = (swidth + 3) & ~0x3;     /*Round to 4*/
-    line_1d_blur_size *= sizeof(lv_opa_t);
-
-    uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size);
-
-    /*Divide the draw buffer*/
-    lv_coord_t  * curve_x = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
-    lv_opa_t * line_1d_blur = (lv_opa_t *)&draw_buf[curve_x_size];
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
 
-    lv_point_t circ;
-    lv_coord_t circ_tmp;
-    lv_circ_init(&circ, &circ_tmp, radius);
-    while(lv_circ_cont(&circ)) {
-        curve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
-        curve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
-        lv_circ_next(&circ, &circ_tmp);
+#if LV_DRAW_SHADOW_CACHE_SIZE
+    /*Only blend the columns if the profile is cached (or can be cached now)*/
+    shadow_cache_entry_t * e = shadow_cache_get(LV_SHADOW_BOTTOM, radius, swidth, opa);
+    if(e == NULL) e = shadow_cache_add_bottom(radius, swidth, opa);
+    if(e) {
+        lv_draw_shadow_bottom_cached(coords, mask, style, radius, swidth, (const uint8_t *)(e + 1));
+        return;
     }
+#endif
 
-    int16_t col;
+    lv_coord_t * curve_x;
+    lv_opa_t * line_1d_blur;
+    lv_draw_shadow_bottom_buf(radius, swidth, opa, &curve_x, &line_1d_blur);
 
-    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
-    for(col = 0; col < swidth; col++) {
-        line_1d_blur[col] = (uint32_t)((uint32_t)(swidth - col) * opa / 2) / (swidth);
-    }
+    int16_t col;
 
     lv_point_t point_l;
     lv_point_t point_r;
@@ -1372,11 +1432,7 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
         for(d = 0; d < swidth; d++) {
             /*When stepping a pixel in y calculate the average with the pixel from the prev. column
              * to make a blur */
-            if(diff == 0) {
-                px_opa = line_1d_blur[d];
-            } else {
-                px_opa = (uint16_t)((uint16_t)line_1d_blur[d] + line_1d_blur[d - diff]) >> 1;
-            }
+            px_opa = lv_draw_shadow_bottom_px_opa(line_1d_blur, diff, d);
             lv_draw_px(point_l.x, point_l.y, mask, style->body.shadow.color, px_opa);
             point_l.y++;
 
@@ -1460,8 +1516,743 @@ static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area
     }
 }
 
+/**
+ * Allocate the buffers of a full shadow in the draw buffer and calculate the quarter circle and the 1D blur
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @param curve_x store the pointer to the 'x' coordinates of the quarter circle here
+ * @param line_1d_blur store the pointer to the 1D blur here
+ * @param line_2d_blur store the pointer to a row of the 2D blur here
+ */
+static void lv_draw_shadow_full_buf(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t ** curve_x,
+                                    uint32_t ** line_1d_blur, lv_opa_t ** line_2d_blur)
+{
+    /*Allocate a draw buffer the buffer required to draw the shadow*/
+    int16_t filter_width = 2 * swidth + 1;
+    uint32_t curve_x_size = ((radius + swidth + 1) + 3) & ~0x3; /*Round to 4*/
+    curve_x_size *= sizeof(lv_coord_t);
+    uint32_t line_1d_blur_size = (filter_width + 3) & ~0x3;     /*Round to 4*/
+    line_1d_blur_size *= sizeof(uint32_t);
+    uint32_t line_2d_blur_size = ((radius + swidth + 1) + 3) & ~0x3;     /*Round to 4*/
+    line_2d_blur_size *= sizeof(lv_opa_t);
+
+    uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size + line_2d_blur_size);
+
+    /*Divide the draw buffer*/
+    *curve_x      = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
+    *line_1d_blur = (uint32_t *)&draw_buf[curve_x_size];
+    *line_2d_blur = (lv_opa_t *)&draw_buf[curve_x_size + line_1d_blur_size];
+
+    memset(*curve_x, 0, curve_x_size);
+    lv_point_t circ;
+    lv_coord_t circ_tmp;
+    lv_circ_init(&circ, &circ_tmp, radius);
+    while(lv_circ_cont(&circ)) {
+        (*curve_x)[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
+        (*curve_x)[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
+        lv_circ_next(&circ, &circ_tmp);
+    }
+
+    /*1D Blur horizontally*/
+    int16_t line;
+    for(line = 0; line < filter_width; line++) {
+        (*line_1d_blur)[line] = (uint32_t)((uint32_t)(filter_width - line) * (opa * 2) << SHADOW_OPA_EXTRA_PRECISION) /
+                                (filter_width * filter_width);
+    }
+}
+
+/**
+ * Calculate a row of a full shadow's corner by making the 1D blur to 2D
+ * @param line the row to calculate (0: the middle point of the radius)
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param curve_x the 'x' coordinates of the quarter circle
+ * @param line_1d_blur the 1D blur
+ * @param line_2d_blur store the opacity of the row's pixels here
+ * @return number of values in `line_2d_blur` (the first one is not drawn on the corners)
+ */
+static uint16_t lv_draw_shadow_full_line(int16_t line, lv_coord_t radius, lv_coord_t swidth, const lv_coord_t * curve_x,
+                                         const uint32_t * line_1d_blur, lv_opa_t * line_2d_blur)
+{
+    bool line_ready = false;
+    uint16_t col;
+    for(col = 0; col <= radius + swidth; col++) { /*Check all pixels in a 1D blur line (from the origo to last
+                                                     shadow pixel (radius + swidth))*/
+
+        /*Sum the opacities from the lines above and below this 'row'*/
+        int16_t line_rel;
+        uint32_t px_opa_sum = 0;
+        for(line_rel = -swidth; line_rel <= swidth; line_rel++) {
+            /*Get the relative x position of the 'line_rel' to 'line'*/
+            int16_t col_rel;
+            if(line + line_rel < 0) { /*Below the radius, here is the blur of the edge */
+                col_rel = radius - curve_x[line] - col;
+            } else if(line + line_rel > radius) { /*Above the radius, here won't be more 1D blur*/
+                break;
+            } else { /*Blur from the curve*/
+                col_rel = curve_x[line + line_rel] - curve_x[line] - col;
+            }
+
+            /*Add the value of the 1D blur on 'col_rel' position*/
+            if(col_rel < -swidth) { /*Outside of the blurred area. */
+                if(line_rel == -swidth)
+                    line_ready = true; /*If no data even on the very first line then it wont't
+                                          be anything else in this line*/
+                break;                 /*Break anyway because only smaller 'col_rel' values will come */
+            } else if(col_rel > swidth)
+                px_opa_sum += line_1d_blur[0]; /*Inside the not blurred area*/
+            else
+                px_opa_sum += line_1d_blur[swidth - col_rel]; /*On the 1D blur (+ swidth to align to the center)*/
+        }
+
+        line_2d_blur[col] = px_opa_sum >> SHADOW_OPA_EXTRA_PRECISION;
+        if(line_ready) {
+            col++; /*To make this line to the last one ( drawing will go to '< col')*/
+            break;
+        }
+    }
+
+    return col;
+}
+
+/**
+ * Allocate the buffers of a bottom shadow in the draw buffer and calculate the quarter circle and the 1D blur
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow (with the anti-aliasing extra)
+ * @param opa opacity of the shadow
+ * @param curve_x store the pointer to the 'x' coordinates of the quarter circle here
+ * @param line_1d_blur store the pointer to the 1D blur here
+ */
+static void lv_draw_shadow_bottom_buf(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t ** curve_x,
+                                      lv_opa_t ** line_1d_blur)
+{
+    uint32_t curve_x_size = ((radius + 1) + 3) & ~0x3; /*Round to 4*/
+    curve_x_size *= sizeof(lv_coord_t);
+    lv_opa_t line_1d_blur_size = (swidth + 3) & ~0x3;     /*Round to 4*/
+    line_1d_blur_size *= sizeof(lv_opa_t);
+
+    uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size);
+
+    /*Divide the draw buffer*/
+    *curve_x      = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
+    *line_1d_blur = (lv_opa_t *)&draw_buf[curve_x_size];
+
+    lv_point_t circ;
+    lv_coord_t circ_tmp;
+    lv_circ_init(&circ, &circ_tmp, radius);
+    while(lv_circ_cont(&circ)) {
+        (*curve_x)[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
+        (*curve_x)[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
+        lv_circ_next(&circ, &circ_tmp);
+    }
+
+    int16_t col;
+    for(col = 0; col < swidth; col++) {
+        (*line_1d_blur)[col] = (uint32_t)((uint32_t)(swidth - col) * opa / 2) / (swidth);
+    }
+}
+
+/**
+ * Get the opacity of a pixel of a bottom shadow's corner
+ * @param line_1d_blur the 1D blur
+ * @param diff step in y from the previous column
+ * @param d index of the pixel in the column
+ * @return the opacity of the pixel
+ */
+static lv_opa_t lv_draw_shadow_bottom_px_opa(const lv_opa_t * line_1d_blur, int16_t diff, uint16_t d)
+{
+    if(diff == 0) return line_1d_blur[d];
+    else if(d < diff) return line_1d_blur[d] >> 1; /*The previous column has no pixel here*/
+    else return (uint16_t)((uint16_t)line_1d_blur[d] + line_1d_blur[d - diff]) >> 1;
+}
+
+#if LV_DRAW_SHADOW_CACHE_SIZE
+
+/**
+ * Draw a full shadow from a cached profile
+ * @param coords the coordinates of the original rectangle
+ * @param mask draw only on this area
+ * @param style pointer to a rectangle style
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param prof the profile: `shadow_row_t` and the opacity values for every row
+ */
+static void lv_draw_shadow_full_cached(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                                       lv_coord_t radius, lv_coord_t swidth, const uint8_t * prof)
+{
+    bool aa          = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+    lv_color_t color = style->body.shadow.color;
+
+    /*Origo of the corners*/
+    lv_coord_t ofs_l = coords->x1 + radius + aa;
+    lv_coord_t ofs_r = coords->x2 - radius - aa;
+    lv_coord_t ofs_t = coords->y1 + radius + aa;
+    lv_coord_t ofs_b = coords->y2 - radius - aa;
+
+    lv_area_t area_l;
+    lv_area_t area_r;
+    int16_t line;
+    for(line = 0; line <= radius + swidth; line++) {
+        const shadow_row_t * row = (const shadow_row_t *)prof;
+        const lv_opa_t * map     = (const lv_opa_t *)(row + 1);
+        prof += sizeof(shadow_row_t) + ((row->cnt + 1) & ~0x1);
+
+        /*The first line is used only on the edges*/
+        if(line == 0) {
+            lv_draw_shadow_full_straight(coords, mask, style, map);
+            continue;
+        }
+
+        /*The first value is on the curve, it's not drawn*/
+        if(row->cnt < 2) continue;
+
+        area_l.x2 = ofs_l - row->x - 1;
+        area_l.x1 = area_l.x2 - (row->cnt - 2);
+        area_r.x1 = ofs_r + row->x + 1;
+        area_r.x2 = area_r.x1 + (row->cnt - 2);
+
+        /*Top corners*/
+        area_l.y1 = ofs_t - line;
+        area_l.y2 = area_l.y1;
+        area_r.y1 = area_l.y1;
+        area_r.y2 = area_l.y1;
+        lv_draw_opa_map(&area_l, mask, &map[1], true, false, color, LV_OPA_COVER);
+        lv_draw_opa_map(&area_r, mask, &map[1], false, false, color, LV_OPA_COVER);
+
+        /*Bottom corners*/
+        area_l.y1 = ofs_b + line;
+        area_l.y2 = area_l.y1;
+        area_r.y1 = area_l.y1;
+        area_r.y2 = area_l.y1;
+        lv_draw_opa_map(&area_l, mask, &map[1], true, false, color, LV_OPA_COVER);
+        lv_draw_opa_map(&area_r, mask, &map[1], false, false, color, LV_OPA_COVER);
+    }
+}
+
+/**
+ * Draw a bottom shadow from a cached profile
+ * @param coords the coordinates of the original rectangle
+ * @param mask draw only on this area
+ * @param style pointer to a rectangle style
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow (with the anti-aliasing extra)
+ * @param prof the profile: `curve_x`, the 1D blur and the opacity values of the corners' columns
+ */
+static void lv_draw_shadow_bottom_cached(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                                         lv_coord_t radius, lv_coord_t swidth, const uint8_t * prof)
+{
+    bool aa          = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+    lv_color_t color = style->body.shadow.color;
+
+    const lv_coord_t * curve_x    = (const lv_coord_t *)prof;
+    const lv_opa_t * line_1d_blur = &prof[(radius + 1) * sizeof(lv_coord_t)];
+    const lv_opa_t * col_opa      = &line_1d_blur[swidth];
+
+    lv_coord_t ofs_l = coords->x1 + radius;
+    lv_coord_t ofs_r = coords->x2 - radius;
+    lv_coord_t ofs_y = coords->y2 - radius + 1 - aa;
+
+    lv_area_t area;
+    lv_coord_t col;
+    for(col = 0; col <= radius; col++) {
+        area.y1 = ofs_y + curve_x[col];
+        area.y2 = area.y1 + swidth - 1;
+
+        area.x1 = ofs_l - col;
+        area.x2 = area.x1;
+        lv_draw_opa_map(&area, mask, col_opa, false, false, color, LV_OPA_COVER);
+
+        /*Don't overdraw the pixel on the middle*/
+        if(ofs_r + col > ofs_l) {
+            area.x1 = ofs_r + col;
+            area.x2 = area.x1;
+            lv_draw_opa_map(&area, mask, col_opa, false, false, color, LV_OPA_COVER);
+        }
+
+        col_opa += swidth;
+    }
+
+    area.x1 = ofs_l + 1;
+    area.y1 = ofs_y + radius;
+    area.x2 = ofs_r - 1;
+    area.y2 = area.y1;
+
+    lv_coord_t d;
+    for(d = 0; d < swidth; d++) {
+        lv_draw_fill(&area, mask, color, line_1d_blur[d]);
+        area.y1++;
+        area.y2++;
+    }
+}
+
+/**
+ * Calculate the profile of a full shadow and add it to the cache
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return the new entry or NULL if the profile is too large for the cache
+ */
+static shadow_cache_entry_t * shadow_cache_add_full(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa)
+{
+    /*A row has at most `lines` values. Allocate for the worst case and free the rest at the end*/
+    uint32_t lines = radius + swidth + 1;
+    shadow_cache_entry_t * e =
+        shadow_cache_add(LV_SHADOW_FULL, radius, swidth, opa, lines * (sizeof(shadow_row_t) + lines + 1));
+    if(e == NULL) return NULL;
+
+    lv_coord_t * curve_x;
+    uint32_t * line_1d_blur;
+    lv_opa_t * line_2d_blur;
+    lv_draw_shadow_full_buf(radius, swidth, opa, &curve_x, &line_1d_blur, &line_2d_blur);
+
+    uint8_t * prof = (uint8_t *)(e + 1);
+    uint8_t * p    = prof;
+    int16_t line;
+    for(line = 0; line <= radius + swidth; line++) {
+        shadow_row_t * row = (shadow_row_t *)p;
+        row->x             = curve_x[line];
+        row->cnt           = lv_draw_shadow_full_line(line, radius, swidth, curve_x, line_1d_blur, line_2d_blur);
+        memcpy(row + 1, line_2d_blur, row->cnt);
+        p += sizeof(shadow_row_t) + ((row->cnt + 1) & ~0x1);
+    }
+
+    /*Give back the unused part. It's the most recently used entry so it's the head*/
+    uint32_t size = p - prof;
+    shadow_cache_entry_t * e_trunc = lv_mem_realloc(e, sizeof(shadow_cache_entry_t) + size);
+    if(e_trunc == NULL) return e;
+
+    shadow_cache_used -= e_trunc->size - size;
+    e_trunc->size     = size;
+    shadow_cache_head = e_trunc;
+
+    return e_trunc;
+}
+
+/**
+ * Calculate the profile of a bottom shadow and add it to the cache
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow (with the anti-aliasing extra)
+ * @param opa opacity of the shadow
+ * @return the new entry or NULL if the profile is too large for the cache
+ */
+static shadow_cache_entry_t * shadow_cache_add_bottom(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa)
+{
+    uint32_t curve_x_size    = (radius + 1) * sizeof(lv_coord_t);
+    shadow_cache_entry_t * e = shadow_cache_add(LV_SHADOW_BOTTOM, radius, swidth, opa,
+                                                curve_x_size + swidth + (uint32_t)(radius + 1) * swidth);
+    if(e == NULL) return NULL;
+
+    lv_coord_t * curve_x;
+    lv_opa_t * line_1d_blur;
+    lv_draw_shadow_bottom_buf(radius, swidth, opa, &curve_x, &line_1d_blur);
+
+    uint8_t * prof = (uint8_t *)(e + 1);
+    memcpy(prof, curve_x, curve_x_size);
+    memcpy(&prof[curve_x_size], line_1d_blur, swidth);
+
+    lv_opa_t * col_opa = &prof[curve_x_size + swidth];
+    lv_coord_t col;
+    for(col = 0; col <= radius; col++) {
+        int16_t diff = col == 0 ? 0 : curve_x[col - 1] - curve_x[col];
+        uint16_t d;
+        for(d = 0; d < swidth; d++) {
+            *col_opa = lv_draw_shadow_bottom_px_opa(line_1d_blur, diff, d);
+            col_opa++;
+        }
+    }
+
+    return e;
+}
+
+/**
+ * Find a shadow profile in the cache and make it the most recently used
+ * @param type LV_SHADOW_FULL or LV_SHADOW_BOTTOM
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return the entry of the profile or NULL if not cached
+ */
+static shadow_cache_entry_t * shadow_cache_get(uint8_t type, lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa)
+{
+    shadow_cache_entry_t * prev = NULL;
+    shadow_cache_entry_t * e    = shadow_cache_head;
+    while(e) {
+        if(e->radius == radius && e->swidth == swidth && e->opa == opa && e->type == type) {
+            if(prev) {
+                prev->next        = e->next;
+                e->next           = shadow_cache_head;
+                shadow_cache_head = e;
+            }
+            shadow_cache_hit++;
+            return e;
+        }
+        prev = e;
+        e    = e->next;
+    }
+
+    shadow_cache_miss++;
+    return NULL;
+}
+
+/**
+ * Allocate a new profile in the cache. The least recently used profiles are freed to make room.
+ * @param type LV_SHADOW_FULL or LV_SHADOW_BOTTOM
+ * @param radius radius of the shadow (with the anti-aliasing extra)
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @param size size of the profile in bytes
+ * @return the new entry (the profile is after it) or NULL if it doesn't fit into the cache
+ */
+static shadow_cache_entry_t * shadow_cache_add(uint8_t type, lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa,
+                                               uint32_t size)
+{
+    if(size > LV_DRAW_SHADOW_CACHE_SIZE) return NULL;
+
+    /*Free the least recently used profiles until the new one fits*/
+    while(shadow_cache_head && shadow_cache_used + size > LV_DRAW_SHADOW_CACHE_SIZE) {
+        shadow_cache_entry_t ** last = &shadow_cache_head;
+        while((*last)->next) last = &(*last)->next;
+        shadow_cache_used -= (*last)->size;
+        lv_mem_free(*last);
+        *last = NULL;
+    }
+
+    shadow_cache_entry_t * e = lv_mem_alloc(sizeof(shadow_cache_entry_t) + size);
+    if(e == NULL) return NULL; /*Out of memory: draw without the cache*/
+
+    e->radius         = radius;
+    e->swidth         = swidth;
+    e->opa            = opa;
+    e->type           = type;
+    e->size           = size;
+    e->next           = shadow_cache_head;
+    shadow_cache_head = e;
+    shadow_cache_used += size;
+
+    return e;
+}
+
+#endif /*LV_DRAW_SHADOW_CACHE_SIZE*/
+
+#endif
+
+/**
+ * Fill an area of a corner. Draw the coverage to `corner_gen_map` if a corner mask is created.
+ * Same parameters as `lv_draw_fill`
+ */
+static void corner_fill(const lv_area_t * area, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_DRAW_CORNER_CACHE_SIZE
+    if(corner_gen_map) {
+        if(opa < LV_OPA_MIN) return;
+        if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+        lv_area_t a;
+        if(lv_area_intersect(&a, area, mask) == false) return;
+
+        /*Mix the opacity as `lv_color_mix` would mix a color channel*/
+        lv_coord_t x;
+        lv_coord_t y;
+        for(y = a.y1; y <= a.y2; y++) {
+            lv_opa_t * px = &corner_gen_map[(uint32_t)y * corner_gen_w + a.x1];
+            for(x = a.x1; x <= a.x2; x++) {
+                if(opa == LV_OPA_COVER) *px = LV_OPA_COVER;
+                else *px = (uint16_t)((uint16_t)LV_OPA_COVER * opa + (uint16_t)*px * (255 - opa)) >> 8;
+                px++;
+            }
+        }
+        return;
+    }
+#endif
+
+    lv_draw_fill(area, mask, color, opa);
+}
+
+/**
+ * Draw a pixel of a corner. Draw the coverage to `corner_gen_map` if a corner mask is created.
+ * Same parameters as `lv_draw_px`
+ */
+static void corner_px(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+#if LV_DRAW_CORNER_CACHE_SIZE
+    if(corner_gen_map) {
+        lv_area_t a;
+        lv_area_set(&a, x, y, x, y);
+        corner_fill(&a, mask, color, opa);
+        return;
+    }
 #endif
 
+    lv_draw_px(x, y, mask, color, opa);
+}
+
+#if LV_DRAW_CORNER_CACHE_SIZE
+
+/**
+ * Draw the top and bottom parts (corners) of a rectangle with a cached corner mask
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only  on this area
+ * @param style pointer to a rectangle style
+ * @param radius the radius after `lv_draw_cont_radius_corr`
+ * @param opa opacity of the body
+ * @return true: ready; false: can't be drawn with a mask, draw it normally
+ */
+static bool lv_draw_rect_main_corner_cached(const lv_area_t * coords, const lv_area_t * mask,
+                                            const lv_style_t * style, uint16_t radius, lv_opa_t opa)
+{
+    bool aa           = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+    lv_coord_t size   = radius + aa + 1;
+    lv_coord_t height = lv_area_get_height(coords);
+
+    /*The top and bottom corners can't be on each other*/
+    if(lv_area_get_width(coords) < 2 * size || height < 2 * size) return false;
+
+    /*Nothing to draw if the mask is between the corners*/
+    if(mask->y1 >= coords->y1 + size && mask->y2 <= coords->y2 - size) return true;
+
+    const corner_cache_entry_t * e = corner_cache_get(radius, -1, style);
+    if(e == NULL) return false;
+
+    lv_color_t mcolor = style->body.main_color;
+    lv_color_t gcolor = style->body.grad_color;
+    lv_color_t act_color = mcolor;
+
+    lv_coord_t r;
+    for(r = 0; r < size; r++) {
+        lv_coord_t y;
+        uint8_t i;
+        for(i = 0; i < 2; i++) {
+            y = i == 0 ? coords->y1 + r : coords->y2 - r;
+            if(y < mask->y1 || y > mask->y2) continue;
+
+            if(mcolor.full != gcolor.full) {
+                uint8_t mix = (uint32_t)((uint32_t)(coords->y2 - y) * 255) / height;
+                act_color   = lv_color_mix(mcolor, gcolor, mix);
+            }
+
+            corner_draw_row(e, r, coords->x1, coords->x2, y, mask, act_color, opa, true);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Draw the corners of a rectangle border with a cached corner mask
+ * @param coords the coordinates of the original rectangle
+ * @param mask the rectangle will be drawn only  on this area
+ * @param style pointer to a rectangle style
+ * @param radius the radius after `lv_draw_cont_radius_corr`
+ * @param opa opacity of the border
+ * @return true: ready; false: can't be drawn with a mask, draw it normally
+ */
+static bool lv_draw_rect_border_corner_cached(const lv_area_t * coords, const lv_area_t * mask,
+                                              const lv_style_t * style, uint16_t radius, lv_opa_t opa)
+{
+    bool aa         = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+    lv_coord_t size = radius + aa + 1;
+
+    /*The top and bottom corners can't be on each other*/
+    if(lv_area_get_width(coords) < 2 * size || lv_area_get_height(coords) < 2 * size) return false;
+
+    /*Nothing to draw if the mask is between the corners*/
+    if(mask->y1 >= coords->y1 + size && mask->y2 <= coords->y2 - size) return true;
+
+    const corner_cache_entry_t * e = corner_cache_get(radius, style->body.border.width, style);
+    if(e == NULL) return false;
+
+    lv_coord_t r;
+    for(r = 0; r < size; r++) {
+        lv_coord_t y = coords->y1 + r;
+        if(y >= mask->y1 && y <= mask->y2) {
+            corner_draw_row(e, r, coords->x1, coords->x2, y, mask, style->body.border.color, opa, false);
+        }
+
+        y = coords->y2 - r;
+        if(y >= mask->y1 && y <= mask->y2) {
+            corner_draw_row(e, r, coords->x1, coords->x2, y, mask, style->body.border.color, opa, false);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Draw a row of the left and right corner from a mask.
+ * The covered part is filled, only the anti-aliased pixels are blended one by one.
+ * @param e pointer to a cached corner
+ * @param r row of the mask
+ * @param x1 left edge of the rectangle
+ * @param x2 right edge of the rectangle
+ * @param y the row to draw
+ * @param mask draw only on this area
+ * @param color color of the row
+ * @param opa opacity of the row
+ * @param body true: fill between the corners too
+ */
+static void corner_draw_row(const corner_cache_entry_t * e, lv_coord_t r, lv_coord_t x1, lv_coord_t x2, lv_coord_t y,
+                            const lv_area_t * mask, lv_color_t color, lv_opa_t opa, bool body)
+{
+    lv_coord_t size           = e->size;
+    const lv_opa_t * map_row  = &e->map[(uint32_t)r * size];
+    const corner_row_t * part = &((const corner_row_t *)&e->map[(uint32_t)size * size])[r];
+    lv_area_t area;
+
+    /*Anti-aliased pixels on the outer edge*/
+    if(part->aa1 < part->full) {
+        lv_area_set(&area, x1 + part->aa1, y, x1 + part->full - 1, y);
+        lv_draw_opa_map(&area, mask, &map_row[part->aa1], false, false, color, opa);
+        lv_area_set(&area, x2 - part->full + 1, y, x2 - part->aa1, y);
+        lv_draw_opa_map(&area, mask, &map_row[part->aa1], true, false, color, opa);
+    }
+
+    /*Covered till the end of the corner: fill it to the other corner in one step*/
+    if(body && part->aa2 == size) {
+        lv_area_set(&area, x1 + part->full, y, x2 - part->full, y);
+        lv_draw_fill(&area, mask, color, opa);
+        return;
+    }
+
+    if(part->full < part->aa2) {
+        lv_area_set(&area, x1 + part->full, y, x1 + part->aa2 - 1, y);
+        lv_draw_fill(&area, mask, color, opa);
+        lv_area_set(&area, x2 - part->aa2 + 1, y, x2 - part->full, y);
+        lv_draw_fill(&area, mask, color, opa);
+    }
+
+    /*Anti-aliased pixels on the inner edge*/
+    if(part->aa2 < part->end) {
+        lv_area_set(&area, x1 + part->aa2, y, x1 + part->end - 1, y);
+        lv_draw_opa_map(&area, mask, &map_row[part->aa2], false, false, color, opa);
+        lv_area_set(&area, x2 - part->end + 1, y, x2 - part->aa2, y);
+        lv_draw_opa_map(&area, mask, &map_row[part->aa2], true, false, color, opa);
+    }
+
+    if(body) {
+        lv_area_set(&area, x1 + size, y, x2 - size, y);
+        lv_draw_fill(&area, mask, color, opa);
+    }
+}
+
+/**
+ * Get the mask of the top left corner from the cache.
+ * A mask is created only when it's asked the second time while it's still in the cache.
+ * The masks use at most `LV_DRAW_CORNER_CACHE_MEM` bytes, the least recently used ones are freed for a new one.
+ * @param radius the radius after `lv_draw_cont_radius_corr`
+ * @param bwidth border width or -1 for the body
+ * @param style the style of the rectangle (only its type matters, the colors are not used)
+ * @return pointer to a cached corner or NULL if there is no mask
+ */
+static const corner_cache_entry_t * corner_cache_get(uint16_t radius, int16_t bwidth, const lv_style_t * style)
+{
+    uint8_t aa = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing()) ? 1 : 0;
+    if(radius > CORNER_CACHE_MAX_RADIUS) return NULL;
+
+    corner_cache_life++;
+
+    /*Find the corner or the least recently used entry*/
+    corner_cache_entry_t * e = &corner_cache[0];
+    uint16_t i;
+    for(i = 0; i < LV_DRAW_CORNER_CACHE_SIZE; i++) {
+        corner_cache_entry_t * c = &corner_cache[i];
+        if(c->life != 0 && c->radius == radius && c->bwidth == bwidth && c->aa == aa) {
+            e = c;
+            break;
+        }
+        if(c->life < e->life) e = c;
+    }
+
+    /*First time: only remember it. Drawing it normally is cheaper than creating a mask for only one use*/
+    if(i == LV_DRAW_CORNER_CACHE_SIZE) {
+        if(e->map) {
+            lv_mem_free(e->map);
+            corner_cache_used -= CORNER_MAP_SIZE(e->size);
+        }
+        e->map    = NULL;
+        e->life   = corner_cache_life;
+        e->radius = radius;
+        e->bwidth = bwidth;
+        e->aa     = aa;
+        e->size   = radius + aa + 1;
+        return NULL;
+    }
+
+    e->life = corner_cache_life;
+    if(e->map) return e;
+
+    lv_coord_t size   = e->size;
+    uint32_t map_size = CORNER_MAP_SIZE(size);
+    if(map_size > LV_DRAW_CORNER_CACHE_MEM) return NULL;
+
+    /*Free the least recently used masks till the new one fits*/
+    while(corner_cache_used + map_size > LV_DRAW_CORNER_CACHE_MEM) {
+        corner_cache_entry_t * lru = NULL;
+        for(i = 0; i < LV_DRAW_CORNER_CACHE_SIZE; i++) {
+            corner_cache_entry_t * c = &corner_cache[i];
+            if(c->map && (lru == NULL || c->life < lru->life)) lru = c;
+        }
+        lv_mem_free(lru->map);
+        lru->map = NULL;
+        corner_cache_used -= CORNER_MAP_SIZE(lru->size);
+    }
+
+    lv_opa_t * map = lv_mem_alloc(map_size);
+    if(map == NULL) return NULL;
+    memset(map, 0, (uint32_t)size * size);
+
+    /*Draw the corners of a large enough square straight to the mask. Only the top left corner is on it*/
+    lv_style_t gen_style;
+    lv_style_copy(&gen_style, style);
+    gen_style.body.radius      = radius + aa; /*`lv_draw_cont_radius_corr` will give `radius` again*/
+    gen_style.body.opa         = LV_OPA_COVER;
+    gen_style.body.grad_color  = gen_style.body.main_color;
+    gen_style.body.border.opa  = LV_OPA_COVER;
+    gen_style.body.border.part = LV_BORDER_FULL;
+    if(bwidth >= 0) gen_style.body.border.width = bwidth;
+
+    lv_area_t gen_coords;
+    lv_area_t gen_mask;
+    lv_area_set(&gen_coords, 0, 0, 2 * size + 1, 2 * size + 1);
+    lv_area_set(&gen_mask, 0, 0, size - 1, size - 1);
+
+    corner_gen_map = map;
+    corner_gen_w   = size;
+    if(bwidth < 0) lv_draw_rect_main_corner(&gen_coords, &gen_mask, &gen_style, LV_OPA_COVER);
+    else lv_draw_rect_border_corner(&gen_coords, &gen_mask, &gen_style, LV_OPA_COVER);
+    corner_gen_map = NULL;
+
+    corner_row_t * parts = (corner_row_t *)&map[(uint32_t)size * size];
+    lv_coord_t y;
+    for(y = 0; y < size; y++) {
+        lv_opa_t * row = &map[(uint32_t)y * size];
+
+        /*Find the parts of the row*/
+        corner_row_t * part = &parts[y];
+        uint8_t x = 0;
+        while(x < size && row[x] == LV_OPA_TRANSP) x++;
+        part->aa1 = x;
+        while(x < size && row[x] != LV_OPA_COVER) x++;
+        part->full = x;
+        while(x < size && row[x] == LV_OPA_COVER) x++;
+        part->aa2 = x;
+        part->end = size;
+        while(part->end > part->aa2 && row[part->end - 1] == LV_OPA_TRANSP) part->end--;
+
+        /*Not a simple row (e.g. a covered pixel among the anti-aliased ones): blend all of it*/
+        if(part->full == size && part->aa1 < size) {
+            part->full = part->end;
+            part->aa2  = part->end;
+        }
+    }
+
+    corner_cache_used += map_size;
+    e->map = map;
+    return e;
+}
+
+#endif /*LV_DRAW_CORNER_CACHE_SIZE*/
+
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h)
 {
     bool aa = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
@@ -36,6 +36,13 @@ extern "C" {
  */
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
 
+/**
+ * Get the hit and miss counters of the shadow profile cache
+ * @param hit store the number of shadows drawn from a cached profile here (can be NULL)
+ * @param miss store the number of shadow profiles calculated here (can be NULL)
+ */
+void lv_draw_shadow_cache_get_stat(uint32_t * hit, uint32_t * miss);
+
 /**********************
  *      MACROS
  **********************/
@@ -14,10 +14,14 @@
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_utils.h"
 #include "../lv_misc/lv_mem.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
+#define ASCII_FIRST         0x20    /*Letters with a direct mapped glyph id*/
+#define ASCII_LAST          0x7E
+#define KERN_CACHE_SIZE     32      /*Kerning values remembered per font, power of 2*/
 
 /**********************
  *      TYPEDEFS
@@ -28,10 +32,38 @@ typedef enum {
     RLE_STATE_COUNTER,
 }rle_state_t;
 
+#if LV_FONT_FMT_TXT_CACHE
+typedef struct {
+    uint16_t gid_left;  /*0: empty entry*/
+    uint16_t gid_right;
+    int8_t value;
+}kern_cache_entry_t;
+
+/*Lookup tables of a font, allocated on first use*/
+typedef struct {
+    uint16_t ascii_gid[ASCII_LAST - ASCII_FIRST + 1];
+    kern_cache_entry_t kern[KERN_CACHE_SIZE];
+}fmt_txt_cache_t;
+#endif
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+/*A decompressed glyph. The bitmap is allocated right after it.*/
+typedef struct _glyph_cache_entry_t {
+    struct _glyph_cache_entry_t * next; /*The next less recently used glyph*/
+    const lv_font_t * font;
+    uint32_t gid;
+    uint32_t size;                      /*Size of the bitmap in bytes*/
+}glyph_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+#if LV_FONT_FMT_TXT_CACHE
+static fmt_txt_cache_t * get_cache(lv_font_fmt_txt_dsc_t * fdsc);
+#endif
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -43,6 +75,9 @@ static uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
 static void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
 static void rle_init(const uint8_t * in,  uint8_t bpp);
 static uint8_t rle_next(void);
+#if LV_FONT_GLYPH_CACHE_SIZE
+static uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t gid, uint32_t size);
+#endif
 
 
 /**********************
@@ -56,6 +91,18 @@ static uint8_t rle_prev_v;
 static uint8_t rle_cnt;
 static rle_state_t rle_state;
 
+#if LV_FONT_FMT_TXT_CACHE
+static uint8_t cache_direct; /*`cache` of a font points here if its first map gives the ASCII glyph ids directly*/
+static uint8_t cache_none;   /*`cache` of a font points here if the tables couldn't be allocated*/
+#endif
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+static glyph_cache_entry_t * glyph_cache_head; /*The most recently used glyph*/
+static uint32_t glyph_cache_used;             /*Bytes used by the cached glyphs*/
+static uint32_t glyph_cache_hit;
+static uint32_t glyph_cache_miss;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -93,14 +140,22 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
 
+        /*Round up, the last byte can be partly used (3 bpp is decompressed to 4 bpp)*/
         uint32_t buf_size = gsize;
         switch(fdsc->bpp) {
-        case 1: buf_size = gsize >> 3;  break;
-        case 2: buf_size = gsize >> 2;  break;
-        case 3: buf_size = gsize >> 1;  break;
-        case 4: buf_size = gsize >> 1;  break;
+        case 1: buf_size = (gsize + 7) >> 3;  break;
+        case 2: buf_size = (gsize + 3) >> 2;  break;
+        case 3: buf_size = (gsize + 1) >> 1;  break;
+        case 4: buf_size = (gsize + 1) >> 1;  break;
         }
 
+#if LV_FONT_GLYPH_CACHE_SIZE
+        /*Decompress only if the glyph is not cached yet*/
+        uint8_t * cached = glyph_cache_get(font, gid, buf_size);
+        if(cached) return cached;
+#endif
+
+        /*Too large for the cache (or no cache): decompress into the common buffer*/
         if(lv_mem_get_size(buf) < buf_size) {
             buf = lv_mem_realloc(buf, buf_size);
             LV_ASSERT_MEM(buf);
@@ -115,6 +170,40 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     return NULL;
 }
 
+/**
+ * Get the hit and miss counters of the glyph cache of compressed fonts
+ * @param hit store the number of glyphs served from the cache here (can be NULL)
+ * @param miss store the number of glyphs decompressed here (can be NULL)
+ */
+void lv_font_glyph_cache_get_stat(uint32_t * hit, uint32_t * miss)
+{
+#if LV_FONT_GLYPH_CACHE_SIZE
+    if(hit) *hit = glyph_cache_hit;
+    if(miss) *miss = glyph_cache_miss;
+#else
+    if(hit) *hit = 0;
+    if(miss) *miss = 0;
+#endif
+}
+
+/**
+ * Free all glyphs from the glyph cache of compressed fonts and clear the counters.
+ * Call it if a font is deleted.
+ */
+void lv_font_glyph_cache_clean(void)
+{
+#if LV_FONT_GLYPH_CACHE_SIZE
+    while(glyph_cache_head) {
+        glyph_cache_entry_t * next = glyph_cache_head->next;
+        lv_mem_free(glyph_cache_head);
+        glyph_cache_head = next;
+    }
+    glyph_cache_used = 0;
+    glyph_cache_hit  = 0;
+    glyph_cache_miss = 0;
+#endif
+}
+
 /**
  * Used as `get_glyph_dsc` callback in LittelvGL's native font format if the font is uncompressed.
  * @param font_p pointer to font
@@ -165,9 +254,37 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
 
+#if LV_FONT_FMT_TXT_CACHE
+    /*Printable ASCII letters are looked up directly*/
+    if(letter >= ASCII_FIRST && letter <= ASCII_LAST) {
+        fmt_txt_cache_t * cache = fdsc->cache;
+        if(cache == NULL) cache = get_cache(fdsc); /*First letter of the font*/
+        if(cache == (fmt_txt_cache_t *)&cache_direct) {
+            return letter - fdsc->cmaps[0].range_start + fdsc->cmaps[0].glyph_id_start;
+        }
+        if(cache && cache != (fmt_txt_cache_t *)&cache_none) return cache->ascii_gid[letter - ASCII_FIRST];
+    }
+#endif
+
     /*Check the cache first*/
     if(letter == fdsc->last_letter) return fdsc->last_glyph_id;
 
+    uint32_t glyph_id = find_glyph_dsc_id(fdsc, letter);
+
+    /*Update the cache*/
+    fdsc->last_letter = letter;
+    fdsc->last_glyph_id = glyph_id;
+    return glyph_id;
+}
+
+/**
+ * Search a letter in the character maps of a font
+ * @param fdsc pointer to a font descriptor
+ * @param letter an unicode letter
+ * @return the glyph id of the letter or 0 if not found
+ */
+static uint32_t find_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
@@ -202,17 +319,50 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        fdsc->last_letter = letter;
-        fdsc->last_glyph_id = glyph_id;
         return glyph_id;
     }
 
-    fdsc->last_letter = letter;
-    fdsc->last_glyph_id = 0;
     return 0;
+}
 
+#if LV_FONT_FMT_TXT_CACHE
+/**
+ * Get the lookup tables of a font. Build them on the first call.
+ * @param fdsc pointer to a font descriptor
+ * @return pointer to the lookup tables, `cache_direct` if the font doesn't need them
+ *         or NULL if they couldn't be allocated
+ */
+static fmt_txt_cache_t * get_cache(lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(fdsc->cache == &cache_none) return NULL;
+    if(fdsc->cache) return fdsc->cache;
+
+    /*The tables don't help if the first map already gives the ASCII glyph ids directly
+     *and the kerning is in classes (no pair search)*/
+    const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[0];
+    if(fdsc->cmap_num > 0 && cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY && cmap->range_start <= ASCII_FIRST &&
+       cmap->range_start + cmap->range_length > ASCII_LAST && (fdsc->kern_dsc == NULL || fdsc->kern_classes)) {
+        fdsc->cache = &cache_direct;
+        return fdsc->cache;
+    }
+
+    fmt_txt_cache_t * cache = lv_mem_alloc(sizeof(fmt_txt_cache_t));
+    LV_ASSERT_MEM(cache);
+    if(cache == NULL) {
+        fdsc->cache = &cache_none; /*Don't try again, search the letters instead*/
+        return NULL;
+    }
+
+    uint32_t letter;
+    for(letter = ASCII_FIRST; letter <= ASCII_LAST; letter++) {
+        cache->ascii_gid[letter - ASCII_FIRST] = find_glyph_dsc_id(fdsc, letter);
+    }
+    memset(cache->kern, 0, sizeof(cache->kern));
+
+    fdsc->cache = cache;
+    return cache;
 }
+#endif
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
 {
@@ -221,6 +371,15 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
     int8_t value = 0;
 
     if(fdsc->kern_classes == 0) {
+#if LV_FONT_FMT_TXT_CACHE
+        /*Searching the pairs is slow so remember the recent ones*/
+        fmt_txt_cache_t * cache = get_cache(fdsc); /*Never `cache_direct` here, that needs kern classes*/
+        kern_cache_entry_t * ke = NULL;
+        if(cache) {
+            ke = &cache->kern[(gid_left * 7 + gid_right) & (KERN_CACHE_SIZE - 1)];
+            if(ke->gid_left == gid_left && ke->gid_right == gid_right) return ke->value;
+        }
+#endif
         /*Kern pairs*/
         const lv_font_fmt_txt_kern_pair_t * kdsc = fdsc->kern_dsc;
         if(kdsc->glyph_ids_size == 0) {
@@ -253,6 +412,14 @@ static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t
         } else {
             /*Invalid value*/
         }
+
+#if LV_FONT_FMT_TXT_CACHE
+        if(ke) {
+            ke->gid_left  = gid_left;
+            ke->gid_right = gid_right;
+            ke->value     = value;
+        }
+#endif
     } else {
         /*Kern classes*/
         const lv_font_fmt_txt_kern_classes_t * kdsc = fdsc->kern_dsc;
@@ -477,3 +644,63 @@ static int32_t unicode_list_compare(const void * ref, const void * element)
 {
     return ((int32_t)(*(uint16_t *)ref)) - ((int32_t)(*(uint16_t *)element));
 }
+
+#if LV_FONT_GLYPH_CACHE_SIZE
+/**
+ * Get a decompressed glyph from the cache. Decompress and add it if it's not cached yet.
+ * The least recently used glyphs are freed to keep the cache in `LV_FONT_GLYPH_CACHE_SIZE`.
+ * @param font pointer to a compressed font
+ * @param gid glyph id in the font
+ * @param size size of the decompressed bitmap in bytes
+ * @return pointer to the decompressed bitmap or NULL if it doesn't fit into the cache
+ */
+static uint8_t * glyph_cache_get(const lv_font_t * font, uint32_t gid, uint32_t size)
+{
+    if(size > LV_FONT_GLYPH_CACHE_SIZE) return NULL;
+
+    /*Search the glyph and move it to the front*/
+    glyph_cache_entry_t * prev = NULL;
+    glyph_cache_entry_t * e    = glyph_cache_head;
+    while(e) {
+        if(e->gid == gid && e->font == font) {
+            if(prev) {
+                prev->next       = e->next;
+                e->next          = glyph_cache_head;
+                glyph_cache_head = e;
+            }
+            glyph_cache_hit++;
+            return (uint8_t *)(e + 1);
+        }
+        prev = e;
+        e    = e->next;
+    }
+
+    glyph_cache_miss++;
+
+    /*Free the least recently used glyphs until the new one fits*/
+    while(glyph_cache_head && glyph_cache_used + size > LV_FONT_GLYPH_CACHE_SIZE) {
+        glyph_cache_entry_t ** last = &glyph_cache_head;
+        while((*last)->next) last = &(*last)->next;
+        glyph_cache_used -= (*last)->size;
+        lv_mem_free(*last);
+        *last = NULL;
+    }
+
+    e = lv_mem_alloc(sizeof(glyph_cache_entry_t) + size);
+    if(e == NULL) return NULL; /*Out of memory: use the common buffer*/
+
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *) font->dsc;
+    uint8_t * bitmap = (uint8_t *)(e + 1);
+    decompress(&fdsc->glyph_bitmap[fdsc->glyph_dsc[gid].bitmap_index], bitmap, fdsc->glyph_dsc[gid].box_w,
+               fdsc->glyph_dsc[gid].box_h, (uint8_t)fdsc->bpp);
+
+    e->font          = font;
+    e->gid           = gid;
+    e->size          = size;
+    e->next          = glyph_cache_head;
+    glyph_cache_head = e;
+    glyph_cache_used += size;
+
+    return bitmap;
+}
+#endif
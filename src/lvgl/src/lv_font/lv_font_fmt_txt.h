@@ -196,6 +196,10 @@ typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
 
+    /*Lookup tables built on first use if `LV_FONT_FMT_TXT_CACHE` is enabled
+     *(glyph ids of the printable ASCII letters and the recently used kerning values)*/
+    void * cache;
+
 }lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -220,6 +224,19 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
  */
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter, uint32_t unicode_letter_next);
 
+/**
+ * Get the hit and miss counters of the glyph cache of compressed fonts
+ * @param hit store the number of glyphs served from the cache here (can be NULL)
+ * @param miss store the number of glyphs decompressed here (can be NULL)
+ */
+void lv_font_glyph_cache_get_stat(uint32_t * hit, uint32_t * miss);
+
+/**
+ * Free all glyphs from the glyph cache of compressed fonts and clear the counters.
+ * Call it if a font is deleted.
+ */
+void lv_font_glyph_cache_clean(void);
+
 /**********************
  *      MACROS
  **********************/
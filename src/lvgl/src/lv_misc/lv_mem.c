@@ -10,6 +10,8 @@
 #include "lv_mem.h"
 #include "lv_math.h"
 #include <string.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 #if LV_MEM_CUSTOM != 0
 #include LV_MEM_CUSTOM_INCLUDE
@@ -29,6 +31,41 @@
 #define MEM_UNIT uint32_t
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/* Two level segregated fit: the free blocks are in lists by size.
+ * The first level is the power of 2 of the size, the second level splits it into `TLSF_SL_CNT` parts.
+ * Bitmaps tell which lists are not empty so a free block is found without searching.*/
+#ifdef LV_ARCH_64
+#define TLSF_ALIGN_LOG2 3
+#else
+#define TLSF_ALIGN_LOG2 2
+#endif
+#define TLSF_ALIGN      (1U << TLSF_ALIGN_LOG2)
+#define TLSF_SL_LOG2    4
+#define TLSF_SL_CNT     (1U << TLSF_SL_LOG2)
+#define TLSF_FL_SHIFT   (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE (1U << TLSF_FL_SHIFT) /*Smaller blocks are in the first list in `TLSF_ALIGN` steps*/
+
+/*The largest block has to be smaller than 2^TLSF_FL_MAX*/
+#if LV_MEM_SIZE <= (64U * 1024U)
+#define TLSF_FL_MAX     16
+#elif LV_MEM_SIZE <= (1024U * 1024U)
+#define TLSF_FL_MAX     20
+#else
+#define TLSF_FL_MAX     30
+#endif
+#define TLSF_FL_CNT     (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+#define TLSF_FREE       0x1 /*Flag in the size: the block is free*/
+#define TLSF_PREV_FREE  0x2 /*Flag in the size: the previous block is free*/
+#define TLSF_FLAGS      (TLSF_FREE | TLSF_PREV_FREE)
+
+#define TLSF_OVERHEAD   sizeof(size_t) /*Only the size is stored in front of a used block*/
+#define TLSF_DATA_OFS   (offsetof(tlsf_block_t, size) + sizeof(size_t))
+#define TLSF_BLOCK_MIN  (sizeof(tlsf_block_t) - sizeof(tlsf_block_t *))
+#define TLSF_BLOCK_MAX  (((size_t)1 << TLSF_FL_MAX) - 1)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -54,24 +91,59 @@ typedef struct
 
 #endif /* LV_ENABLE_GC */
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+/* A block of the TLSF heap. A used block has only `size` in front of its data.
+ * `prev_phys` is stored in the last word of the previous block and it's valid only if that block is free.
+ * The free list links are stored in the data of free blocks.*/
+typedef struct _tlsf_block_t
+{
+    struct _tlsf_block_t * prev_phys; /*The previous block in the memory (if it's free)*/
+    size_t size;                      /*Size of the data and the `TLSF_FREE`, `TLSF_PREV_FREE` flags*/
+    struct _tlsf_block_t * next_free; /*Next block in the same free list (only in free blocks)*/
+    struct _tlsf_block_t * prev_free; /*Previous block in the same free list (only in free blocks)*/
+} tlsf_block_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 #if LV_MEM_CUSTOM == 0
+#if LV_MEM_TLSF
+static void tlsf_init(void);
+static void * tlsf_alloc(size_t size);
+static void tlsf_free(void * data);
+static void tlsf_trunc(void * data, size_t size);
+static bool tlsf_grow(void * data, size_t size);
+#else
 static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
 static void * ent_alloc(lv_mem_ent_t * e, size_t size);
 static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+#endif
+#if LV_MEM_TRACE && LV_ENABLE_GC == 0
+static void * mem_realloc(void * data_p, size_t new_size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_MEM_CUSTOM == 0
 static uint8_t * work_mem;
+#if LV_MEM_TLSF
+static uint32_t tlsf_fl_map;                                /*Bit n: `tlsf_sl_map[n]` is not 0*/
+static uint32_t tlsf_sl_map[TLSF_FL_CNT];                   /*Bit n: `tlsf_lists[fl][n]` is not empty*/
+static tlsf_block_t * tlsf_lists[TLSF_FL_CNT][TLSF_SL_CNT]; /*The free lists*/
+static uint32_t tlsf_used;                                  /*Allocated bytes with the headers*/
+static uint32_t tlsf_max_used;                              /*The highest `tlsf_used`*/
+#endif
 #endif
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_MEM_TRACE
+static lv_mem_trace_cb_t trace_cb;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -95,11 +167,15 @@ void lv_mem_init(void)
     work_mem = (uint8_t *)LV_MEM_ADR;
 #endif
 
+#if LV_MEM_TLSF
+    tlsf_init();
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
 }
 
 /**
@@ -110,11 +186,15 @@ void lv_mem_deinit(void)
 {
 #if LV_MEM_CUSTOM == 0
     memset(work_mem, 0x00, (LV_MEM_SIZE / sizeof(MEM_UNIT)) * sizeof(MEM_UNIT));
+#if LV_MEM_TLSF
+    tlsf_init();
+#else
     lv_mem_ent_t * full = (lv_mem_ent_t *)work_mem;
     full->header.s.used = 0;
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+#endif
 }
 
 /**
@@ -143,7 +223,9 @@ void * lv_mem_alloc(size_t size)
 #endif
     void * alloc = NULL;
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    alloc = tlsf_alloc(size);
+#elif LV_MEM_CUSTOM == 0
     /*Use the built-in allocators*/
     lv_mem_ent_t * e = NULL;
 
@@ -181,6 +263,10 @@ void * lv_mem_alloc(size_t size)
 
     if(alloc == NULL) LV_LOG_WARN("Couldn't allocate memory");
 
+#if LV_MEM_TRACE
+    if(trace_cb) trace_cb(NULL, alloc, size);
+#endif
+
     return alloc;
 }
 
@@ -193,10 +279,18 @@ void lv_mem_free(const void * data)
     if(data == &zero_mem) return;
     if(data == NULL) return;
 
+#if LV_MEM_TRACE
+    if(trace_cb) trace_cb(data, NULL, 0);
+#endif
+
 #if LV_MEM_ADD_JUNK
     memset((void *)data, 0xbb, lv_mem_get_size(data));
 #endif
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    tlsf_free((void *)data);
+#else
+
 #if LV_ENABLE_GC == 0
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
@@ -225,6 +319,7 @@ void lv_mem_free(const void * data)
     LV_MEM_CUSTOM_FREE((void *)data);
 #endif /*LV_ENABLE_GC*/
 #endif
+#endif /*LV_MEM_TLSF*/
 }
 
 /**
@@ -237,20 +332,52 @@ void lv_mem_free(const void * data)
 
 #if LV_ENABLE_GC == 0
 
+#if LV_MEM_TRACE
 void * lv_mem_realloc(void * data_p, size_t new_size)
+{
+    /*Report one reallocation, not the allocation and free it might do*/
+    lv_mem_trace_cb_t cb = trace_cb;
+    trace_cb             = NULL;
+    void * new_p         = mem_realloc(data_p, new_size);
+    trace_cb             = cb;
+    if(cb) cb(data_p, new_p, new_size);
+    return new_p;
+}
+
+static void * mem_realloc(void * data_p, size_t new_size)
+#else
+void * lv_mem_realloc(void * data_p, size_t new_size)
+#endif
 {
     /*data_p could be previously freed pointer (in this case it is invalid)*/
     if(data_p != NULL) {
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+        tlsf_block_t * b = (tlsf_block_t *)((uint8_t *)data_p - TLSF_DATA_OFS);
+        if(b->size & TLSF_FREE) {
+            data_p = NULL;
+        }
+#else
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
         if(e->header.s.used == 0) {
             data_p = NULL;
         }
+#endif
     }
 
     uint32_t old_size = lv_mem_get_size(data_p);
     if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    if(data_p != NULL && data_p != &zero_mem && new_size != 0) {
+        /* Truncate the memory if the new size is smaller. */
+        if(new_size < old_size) {
+            tlsf_trunc(data_p, new_size);
+            return data_p;
+        }
+        /* Take the next block if it's free and large enough */
+        if(tlsf_grow(data_p, new_size)) return data_p;
+    }
+#elif LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
@@ -291,7 +418,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
  */
 void lv_mem_defrag(void)
 {
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /*Nothing to do: the free blocks are always joined*/
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e_free;
     lv_mem_ent_t * e_next;
     e_free = ent_get_next(NULL);
@@ -337,7 +466,30 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 {
     /*Init the data*/
     memset(mon_p, 0, sizeof(lv_mem_monitor_t));
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    /*Walk the blocks in memory order until the closing 0 size block*/
+    tlsf_block_t * b = (tlsf_block_t *)(work_mem - offsetof(tlsf_block_t, size));
+    while((b->size & ~TLSF_FLAGS) != 0) {
+        size_t size = b->size & ~TLSF_FLAGS;
+        if(b->size & TLSF_FREE) {
+            mon_p->free_cnt++;
+            mon_p->free_size += size;
+            if(size > mon_p->free_biggest_size) {
+                mon_p->free_biggest_size = size;
+            }
+        } else {
+            mon_p->used_cnt++;
+        }
+        b = (tlsf_block_t *)((uint8_t *)b + TLSF_DATA_OFS + size - sizeof(tlsf_block_t *));
+    }
+    mon_p->total_size = LV_MEM_SIZE;
+    mon_p->max_used   = tlsf_max_used;
+    mon_p->used_pct   = 100 - (100U * mon_p->free_size) / mon_p->total_size;
+    if(mon_p->free_size > 0) {
+        mon_p->frag_pct = (uint32_t)mon_p->free_biggest_size * 100U / mon_p->free_size;
+        mon_p->frag_pct = 100 - mon_p->frag_pct;
+    }
+#elif LV_MEM_CUSTOM == 0
     lv_mem_ent_t * e;
     e = NULL;
 
@@ -376,6 +528,11 @@ uint32_t lv_mem_get_size(const void * data)
     if(data == NULL) return 0;
     if(data == &zero_mem) return 0;
 
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+    const tlsf_block_t * b = (const tlsf_block_t *)((const uint8_t *)data - TLSF_DATA_OFS);
+    return b->size & ~TLSF_FLAGS;
+#endif
+
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
 
     return e->header.s.d_size;
@@ -390,11 +547,22 @@ uint32_t lv_mem_get_size(const void * data)
 
 #endif /*LV_ENABLE_GC*/
 
+#if LV_MEM_TRACE
+/**
+ * Set a function to call on every allocation, free and reallocation
+ * @param cb the function or NULL to stop tracing
+ */
+void lv_mem_set_trace_cb(lv_mem_trace_cb_t cb)
+{
+    trace_cb = cb;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-#if LV_MEM_CUSTOM == 0
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF == 0
 /**
  * Give the next entry after 'act_e'
  * @param act_e pointer to an entry
@@ -479,3 +647,302 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
 }
 
 #endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_TLSF
+
+/**
+ * Index of the most significant set bit
+ * @param x a non-zero number
+ * @return 0..31
+ */
+static inline uint32_t tlsf_fls(uint32_t x)
+{
+#if defined(__GNUC__)
+    return 31 - __builtin_clz(x);
+#else
+    uint32_t i = 0;
+    while(x >>= 1) i++;
+    return i;
+#endif
+}
+
+/**
+ * Index of the least significant set bit
+ * @param x a non-zero number
+ * @return 0..31
+ */
+static inline uint32_t tlsf_ffs(uint32_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctz(x);
+#else
+    return tlsf_fls(x & (~x + 1));
+#endif
+}
+
+static inline size_t tlsf_size(const tlsf_block_t * b)
+{
+    return b->size & ~TLSF_FLAGS;
+}
+
+static inline void * tlsf_to_data(const tlsf_block_t * b)
+{
+    return (uint8_t *)b + TLSF_DATA_OFS;
+}
+
+/*The block after `b` in the memory. Its `prev_phys` is in the last word of `b`*/
+static inline tlsf_block_t * tlsf_next(const tlsf_block_t * b)
+{
+    return (tlsf_block_t *)((uint8_t *)tlsf_to_data(b) + tlsf_size(b) - sizeof(tlsf_block_t *));
+}
+
+/**
+ * Get the list of a size
+ * @param size size of a block
+ * @param fl store the first level index here
+ * @param sl store the second level index here
+ */
+static inline void tlsf_mapping(size_t size, uint32_t * fl, uint32_t * sl)
+{
+    if(size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = (uint32_t)size >> TLSF_ALIGN_LOG2;
+    } else {
+        uint32_t f = tlsf_fls((uint32_t)size);
+        *sl        = ((uint32_t)size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_CNT;
+        *fl        = f - TLSF_FL_SHIFT + 1;
+    }
+}
+
+static void tlsf_insert(tlsf_block_t * b)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(tlsf_size(b), &fl, &sl);
+
+    tlsf_block_t * head = tlsf_lists[fl][sl];
+    b->next_free        = head;
+    b->prev_free        = NULL;
+    if(head) head->prev_free = b;
+    tlsf_lists[fl][sl] = b;
+
+    tlsf_fl_map |= 1U << fl;
+    tlsf_sl_map[fl] |= 1U << sl;
+}
+
+static void tlsf_remove(tlsf_block_t * b)
+{
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(tlsf_size(b), &fl, &sl);
+
+    if(b->next_free) b->next_free->prev_free = b->prev_free;
+    if(b->prev_free) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        tlsf_lists[fl][sl] = b->next_free;
+        if(tlsf_lists[fl][sl] == NULL) {
+            tlsf_sl_map[fl] &= ~(1U << sl);
+            if(tlsf_sl_map[fl] == 0) tlsf_fl_map &= ~(1U << fl);
+        }
+    }
+}
+
+/*Set the free flag of `b` and tell the next block where its free previous block is*/
+static void tlsf_mark_free(tlsf_block_t * b)
+{
+    tlsf_block_t * next = tlsf_next(b);
+    next->prev_phys     = b;
+    next->size |= TLSF_PREV_FREE;
+    b->size |= TLSF_FREE;
+}
+
+static void tlsf_mark_used(tlsf_block_t * b)
+{
+    tlsf_block_t * next = tlsf_next(b);
+    next->size &= ~(size_t)TLSF_PREV_FREE;
+    b->size &= ~(size_t)TLSF_FREE;
+}
+
+/**
+ * Cut the end of a block into a new free block if it's large enough
+ * @param b pointer to a block, it has to be marked used after this
+ * @param size the size to keep in `b`
+ * @return the new free block (not in a list yet) or NULL if `b` wasn't split
+ */
+static tlsf_block_t * tlsf_split(tlsf_block_t * b, size_t size)
+{
+    if(tlsf_size(b) < size + sizeof(tlsf_block_t)) return NULL;
+
+    tlsf_block_t * rest = (tlsf_block_t *)((uint8_t *)tlsf_to_data(b) + size - sizeof(tlsf_block_t *));
+    rest->size          = tlsf_size(b) - size - TLSF_OVERHEAD;
+    b->size             = size | (b->size & TLSF_FLAGS);
+    tlsf_mark_free(rest);
+
+    return rest;
+}
+
+/*Add `next` (which follows `b` in the memory) to `b`*/
+static void tlsf_absorb(tlsf_block_t * b, tlsf_block_t * next)
+{
+    b->size += tlsf_size(next) + TLSF_OVERHEAD;
+    tlsf_next(b)->prev_phys = b;
+}
+
+/*Join a free block with its free neighbors*/
+static tlsf_block_t * tlsf_merge(tlsf_block_t * b)
+{
+    if(b->size & TLSF_PREV_FREE) {
+        tlsf_block_t * prev = b->prev_phys;
+        tlsf_remove(prev);
+        tlsf_absorb(prev, b);
+        b = prev;
+    }
+
+    tlsf_block_t * next = tlsf_next(b);
+    if(next->size & TLSF_FREE) {
+        tlsf_remove(next);
+        tlsf_absorb(b, next);
+    }
+
+    return b;
+}
+
+/**
+ * Round up a requested size to a block size
+ * @param size requested size in bytes
+ * @return the block size or 0 if it's too large
+ */
+static inline size_t tlsf_adjust(size_t size)
+{
+    size = (size + TLSF_ALIGN - 1) & ~(size_t)(TLSF_ALIGN - 1);
+    if(size < TLSF_BLOCK_MIN) size = TLSF_BLOCK_MIN;
+    if(size > TLSF_BLOCK_MAX) size = 0;
+    return size;
+}
+
+/**
+ * Make the whole work memory one free block closed by a 0 size used block
+ */
+static void tlsf_init(void)
+{
+    memset(tlsf_sl_map, 0, sizeof(tlsf_sl_map));
+    memset(tlsf_lists, 0, sizeof(tlsf_lists));
+    tlsf_fl_map   = 0;
+    tlsf_used     = 0;
+    tlsf_max_used = 0;
+
+    /*The first block's `prev_phys` would be in front of the work memory but it's never used*/
+    tlsf_block_t * b = (tlsf_block_t *)(work_mem - offsetof(tlsf_block_t, size));
+    size_t size      = (LV_MEM_SIZE - 2 * TLSF_OVERHEAD) & ~(size_t)(TLSF_ALIGN - 1);
+    if(size > TLSF_BLOCK_MAX) size = TLSF_BLOCK_MAX & ~(size_t)(TLSF_ALIGN - 1);
+    b->size = size;
+
+    tlsf_block_t * end = tlsf_next(b);
+    end->size          = 0;
+    tlsf_mark_free(b);
+    tlsf_insert(b);
+}
+
+static void * tlsf_alloc(size_t size)
+{
+    size = tlsf_adjust(size);
+    if(size == 0) return NULL;
+
+    /*Round up the size to the next list so any block of that list is large enough*/
+    size_t search = size;
+    if(search >= TLSF_SMALL_SIZE) {
+        search += ((size_t)1 << (tlsf_fls((uint32_t)search) - TLSF_SL_LOG2)) - 1;
+    }
+    uint32_t fl;
+    uint32_t sl;
+    tlsf_mapping(search, &fl, &sl);
+    if(fl >= TLSF_FL_CNT) return NULL;
+
+    /*Find the first not empty list with large enough blocks*/
+    uint32_t sl_map = tlsf_sl_map[fl] & (~0U << sl);
+    if(sl_map == 0) {
+        uint32_t fl_map = tlsf_fl_map & (~0U << (fl + 1));
+        if(fl_map == 0) return NULL;
+        fl     = tlsf_ffs(fl_map);
+        sl_map = tlsf_sl_map[fl];
+    }
+    sl = tlsf_ffs(sl_map);
+
+    tlsf_block_t * b = tlsf_lists[fl][sl];
+    tlsf_remove(b);
+
+    /*Give back the end of the block*/
+    tlsf_block_t * rest = tlsf_split(b, size);
+    if(rest) tlsf_insert(rest);
+    tlsf_mark_used(b);
+
+    tlsf_used += tlsf_size(b) + TLSF_OVERHEAD;
+    if(tlsf_used > tlsf_max_used) tlsf_max_used = tlsf_used;
+
+    return tlsf_to_data(b);
+}
+
+static void tlsf_free(void * data)
+{
+    tlsf_block_t * b = (tlsf_block_t *)((uint8_t *)data - TLSF_DATA_OFS);
+    if(b->size & TLSF_FREE) return; /*Freed already*/
+
+    tlsf_used -= tlsf_size(b) + TLSF_OVERHEAD;
+
+    tlsf_mark_free(b);
+    b = tlsf_merge(b);
+    tlsf_insert(b);
+}
+
+/**
+ * Make a used block smaller and free its end
+ * @param data pointer to the data of a used block
+ * @param size the new size in bytes
+ */
+static void tlsf_trunc(void * data, size_t size)
+{
+    tlsf_block_t * b = (tlsf_block_t *)((uint8_t *)data - TLSF_DATA_OFS);
+    size             = tlsf_adjust(size);
+    if(size == 0) return;
+
+    size_t old_size     = tlsf_size(b);
+    tlsf_block_t * rest = tlsf_split(b, size);
+    if(rest == NULL) return;
+
+    tlsf_used -= old_size - tlsf_size(b);
+    rest = tlsf_merge(rest);
+    tlsf_insert(rest);
+}
+
+/**
+ * Make a used block larger with the following free block
+ * @param data pointer to the data of a used block
+ * @param size the new size in bytes
+ * @return true: `data` is large enough now; false: the next block is not free or too small
+ */
+static bool tlsf_grow(void * data, size_t size)
+{
+    tlsf_block_t * b = (tlsf_block_t *)((uint8_t *)data - TLSF_DATA_OFS);
+    size             = tlsf_adjust(size);
+    if(size == 0) return false;
+
+    tlsf_block_t * next = tlsf_next(b);
+    if((next->size & TLSF_FREE) == 0) return false;
+    if(tlsf_size(b) + TLSF_OVERHEAD + tlsf_size(next) < size) return false;
+
+    size_t old_size = tlsf_size(b);
+    tlsf_remove(next);
+    tlsf_absorb(b, next);
+    tlsf_mark_used(b);
+
+    tlsf_block_t * rest = tlsf_split(b, size);
+    if(rest) tlsf_insert(rest); /*The block after `rest` is used so no need to merge*/
+
+    tlsf_used += tlsf_size(b) - old_size;
+    if(tlsf_used > tlsf_max_used) tlsf_max_used = tlsf_used;
+
+    return true;
+}
+
+#endif
@@ -44,8 +44,17 @@ typedef struct
     uint32_t used_cnt;
     uint8_t used_pct; /**< Percentage used */
     uint8_t frag_pct; /**< Amount of fragmentation */
+    uint32_t max_used; /**< The most memory ever allocated (only with `LV_MEM_TLSF`) */
 } lv_mem_monitor_t;
 
+#if LV_MEM_TRACE
+/**
+ * Called after every allocation (`old_p == NULL`), free (`new_p == NULL`) and reallocation.
+ * The allocations and frees inside a reallocation are not reported.
+ */
+typedef void (*lv_mem_trace_cb_t)(const void * old_p, const void * new_p, size_t size);
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -102,6 +111,14 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p);
  */
 uint32_t lv_mem_get_size(const void * data);
 
+#if LV_MEM_TRACE
+/**
+ * Set a function to call on every allocation, free and reallocation
+ * @param cb the function or NULL to stop tracing
+ */
+void lv_mem_set_trace_cb(lv_mem_trace_cb_t cb);
+#endif
+
 /**********************
  *      MACROS
  **********************/
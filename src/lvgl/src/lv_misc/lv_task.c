@@ -23,6 +23,7 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PRIO LV_TASK_PRIO_MID
 #define DEF_PERIOD 500
+#define HEAP_NONE 0xFFFF /*`heap_id` of tasks not in the heap*/
 
 /**********************
  *      TYPEDEFS
@@ -32,6 +33,9 @@
  *  STATIC PROTOTYPES
  **********************/
 static bool lv_task_exec(lv_task_t * task);
+static void heap_add(lv_task_t * task);
+static void heap_rem(lv_task_t * task);
+static void heap_update(lv_task_t * task);
 
 /**********************
  *  STATIC VARIABLES
@@ -41,6 +45,13 @@ static uint8_t idle_last = 0;
 static bool task_deleted;
 static bool task_created;
 
+/* The running tasks (not `LV_TASK_PRIO_OFF`) in a binary min-heap ordered by the time they are due.
+ * The task list keeps the priority order, the heap tells without a scan if any task is due.*/
+static lv_task_t ** heap;
+static uint16_t heap_cnt;
+static uint16_t heap_size;
+static bool heap_err; /*A task couldn't be added so the heap is not reliable*/
+
 /**********************
  *      MACROS
  **********************/
@@ -56,6 +67,11 @@ void lv_task_core_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_task_ll), sizeof(lv_task_t));
 
+    heap      = NULL;
+    heap_cnt  = 0;
+    heap_size = 0;
+    heap_err  = false;
+
     /*Initially enable the lv_task handling*/
     lv_task_enable(true);
 }
@@ -83,73 +99,76 @@ LV_ATTRIBUTE_TASK_HANDLER void lv_task_handler(void)
 
     handler_start = lv_tick_get();
 
-    /* Run all task from the highest to the lowest priority
-     * If a lower priority task is executed check task again from the highest priority
-     * but on the priority of executed tasks don't run tasks before the executed*/
-    lv_task_t * task_interrupter = NULL;
-    lv_task_t * next;
-    bool end_flag;
-    do {
-        end_flag                 = true;
-        task_deleted             = false;
-        task_created             = false;
-        LV_GC_ROOT(_lv_task_act) = lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
-        while(LV_GC_ROOT(_lv_task_act)) {
-            /* The task might be deleted if it runs only once ('once = 1')
-             * So get next element until the current is surely valid*/
-            next = lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), LV_GC_ROOT(_lv_task_act));
-
-            /*We reach priority of the turned off task. There is nothing more to do.*/
-            if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio == LV_TASK_PRIO_OFF) {
-                break;
-            }
+    /*Scan the task list only if the first task of the heap is due*/
+    if(lv_task_get_next_deadline() == 0) {
+        /* Run all task from the highest to the lowest priority
+         * If a lower priority task is executed check task again from the highest priority
+         * but on the priority of executed tasks don't run tasks before the executed*/
+        lv_task_t * task_interrupter = NULL;
+        lv_task_t * next;
+        bool end_flag;
+        do {
+            end_flag                 = true;
+            task_deleted             = false;
+            task_created             = false;
+            LV_GC_ROOT(_lv_task_act) = lv_ll_get_head(&LV_GC_ROOT(_lv_task_ll));
+            while(LV_GC_ROOT(_lv_task_act)) {
+                /* The task might be deleted if it runs only once ('once = 1')
+                 * So get next element until the current is surely valid*/
+                next = lv_ll_get_next(&LV_GC_ROOT(_lv_task_ll), LV_GC_ROOT(_lv_task_act));
+
+                /*We reach priority of the turned off task. There is nothing more to do.*/
+                if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio == LV_TASK_PRIO_OFF) {
+                    break;
+                }
 
-            /*Here is the interrupter task. Don't execute it again.*/
-            if(LV_GC_ROOT(_lv_task_act) == task_interrupter) {
-                task_interrupter = NULL; /*From this point only task after the interrupter comes, so
-                                            the interrupter is not interesting anymore*/
-                LV_GC_ROOT(_lv_task_act) = next;
-                continue; /*Load the next task*/
-            }
+                /*Here is the interrupter task. Don't execute it again.*/
+                if(LV_GC_ROOT(_lv_task_act) == task_interrupter) {
+                    task_interrupter = NULL; /*From this point only task after the interrupter comes, so
+                                                the interrupter is not interesting anymore*/
+                    LV_GC_ROOT(_lv_task_act) = next;
+                    continue; /*Load the next task*/
+                }
 
-            /*Just try to run the tasks with highest priority.*/
-            if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio == LV_TASK_PRIO_HIGHEST) {
-                lv_task_exec(LV_GC_ROOT(_lv_task_act));
-            }
-            /*Tasks with higher priority than the interrupted shall be run in every case*/
-            else if(task_interrupter) {
-                if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio > task_interrupter->prio) {
+                /*Just try to run the tasks with highest priority.*/
+                if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio == LV_TASK_PRIO_HIGHEST) {
+                    lv_task_exec(LV_GC_ROOT(_lv_task_act));
+                }
+                /*Tasks with higher priority than the interrupted shall be run in every case*/
+                else if(task_interrupter) {
+                    if(((lv_task_t *)LV_GC_ROOT(_lv_task_act))->prio > task_interrupter->prio) {
+                        if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
+                            if(!task_created && !task_deleted) {
+                                /*Check all tasks again from the highest priority */
+                                task_interrupter = LV_GC_ROOT(_lv_task_act);
+                                end_flag = false;
+                                break;
+                            }
+                        }
+                    }
+                }
+                /* It is no interrupter task or we already reached it earlier.
+                 * Just run the remaining tasks*/
+                else {
                     if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
                         if(!task_created && !task_deleted) {
-                            /*Check all tasks again from the highest priority */
-                            task_interrupter = LV_GC_ROOT(_lv_task_act);
-                            end_flag = false;
+                            task_interrupter = LV_GC_ROOT(_lv_task_act); /*Check all tasks again from the highest priority */
+                            end_flag         = false;
                             break;
                         }
                     }
                 }
-            }
-            /* It is no interrupter task or we already reached it earlier.
-             * Just run the remaining tasks*/
-            else {
-                if(lv_task_exec(LV_GC_ROOT(_lv_task_act))) {
-                    if(!task_created && !task_deleted) {
-                        task_interrupter = LV_GC_ROOT(_lv_task_act); /*Check all tasks again from the highest priority */
-                        end_flag         = false;
-                        break;
-                    }
+
+                /*If a task was created or deleted then this or the next item might be corrupted*/
+                if(task_created || task_deleted) {
+                    task_interrupter = NULL;
+                    break;
                 }
-            }
 
-            /*If a task was created or deleted then this or the next item might be corrupted*/
-            if(task_created || task_deleted) {
-                task_interrupter = NULL;
-                break;
+                LV_GC_ROOT(_lv_task_act) = next; /*Load the next task*/
             }
-
-            LV_GC_ROOT(_lv_task_act) = next; /*Load the next task*/
-        }
-    } while(!end_flag);
+        } while(!end_flag);
+    }
 
     busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(idle_period_start);
@@ -213,6 +232,9 @@ lv_task_t * lv_task_create_basic(void)
 
     new_task->user_data = NULL;
 
+    new_task->heap_id = HEAP_NONE;
+    heap_add(new_task);
+
     task_created = true;
 
     return new_task;
@@ -258,6 +280,7 @@ void lv_task_set_cb(lv_task_t * task, lv_task_cb_t task_cb)
  */
 void lv_task_del(lv_task_t * task)
 {
+    heap_rem(task);
     lv_ll_rem(&LV_GC_ROOT(_lv_task_ll), task);
 
     lv_mem_free(task);
@@ -290,6 +313,10 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
     }
 
     task->prio = prio;
+
+    /*Stopped tasks are not in the heap*/
+    if(prio == LV_TASK_PRIO_OFF) heap_rem(task);
+    else heap_add(task);
 }
 
 /**
@@ -300,6 +327,7 @@ void lv_task_set_prio(lv_task_t * task, lv_task_prio_t prio)
 void lv_task_set_period(lv_task_t * task, uint32_t period)
 {
     task->period = period;
+    heap_update(task);
 }
 
 /**
@@ -309,6 +337,7 @@ void lv_task_set_period(lv_task_t * task, uint32_t period)
 void lv_task_ready(lv_task_t * task)
 {
     task->last_run = lv_tick_get() - task->period - 1;
+    heap_update(task);
 }
 
 /**
@@ -328,6 +357,7 @@ void lv_task_once(lv_task_t * task)
 void lv_task_reset(lv_task_t * task)
 {
     task->last_run = lv_tick_get();
+    heap_update(task);
 }
 
 /**
@@ -348,6 +378,21 @@ uint8_t lv_task_get_idle(void)
     return idle_last;
 }
 
+/**
+ * Get the time until the next task is due.
+ * `lv_task_handler()` has nothing to do before it so the caller can sleep or wait for an event until then.
+ * @return time in ms, 0: a task is due now, `LV_TASK_NO_DEADLINE`: there are no running tasks
+ */
+uint32_t lv_task_get_next_deadline(void)
+{
+    if(heap_err) return 0;
+    if(heap_cnt == 0) return LV_TASK_NO_DEADLINE;
+
+    uint32_t elp = lv_tick_elaps(heap[0]->last_run);
+    if(elp >= heap[0]->period) return 0;
+    return heap[0]->period - elp;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -365,6 +410,7 @@ static bool lv_task_exec(lv_task_t * task)
     uint32_t elp = lv_tick_elaps(task->last_run);
     if(elp >= task->period) {
         task->last_run = lv_tick_get();
+        heap_update(task);
         task_deleted   = false;
         task_created   = false;
         if(task->task_cb) task->task_cb(task);
@@ -380,3 +426,114 @@ static bool lv_task_exec(lv_task_t * task)
 
     return exec;
 }
+
+/**
+ * Tell if a task is due earlier than an other
+ * @param a pointer to a task
+ * @param b pointer to an other task
+ * @return true: `a` is due before `b`
+ */
+static inline bool heap_before(const lv_task_t * a, const lv_task_t * b)
+{
+    /*Compare the difference to handle the overflow of the tick*/
+    uint32_t a_due = a->last_run + a->period;
+    uint32_t b_due = b->last_run + b->period;
+    return (int32_t)(a_due - b_due) < 0;
+}
+
+static inline void heap_set(uint16_t id, lv_task_t * task)
+{
+    heap[id]      = task;
+    task->heap_id = id;
+}
+
+/**
+ * Move a task toward the root while it's due earlier than its parent
+ * @param id position of the task in the heap
+ */
+static void heap_sift_up(uint16_t id)
+{
+    lv_task_t * task = heap[id];
+    while(id > 0) {
+        uint16_t parent = (id - 1) / 2;
+        if(!heap_before(task, heap[parent])) break;
+        heap_set(id, heap[parent]);
+        id = parent;
+    }
+    heap_set(id, task);
+}
+
+/**
+ * Move a task toward the leaves while a child is due earlier
+ * @param id position of the task in the heap
+ */
+static void heap_sift_down(uint16_t id)
+{
+    lv_task_t * task = heap[id];
+    while(1) {
+        uint32_t child = 2 * (uint32_t)id + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && heap_before(heap[child + 1], heap[child])) child++;
+        if(!heap_before(heap[child], task)) break;
+        heap_set(id, heap[child]);
+        id = child;
+    }
+    heap_set(id, task);
+}
+
+/**
+ * Add a task to the heap if it's not there yet
+ * @param task pointer to a task
+ */
+static void heap_add(lv_task_t * task)
+{
+    if(task->heap_id != HEAP_NONE) return;
+
+    if(heap_cnt == heap_size) {
+        uint16_t new_size = heap_size == 0 ? 8 : heap_size * 2;
+        lv_task_t ** new_heap = NULL;
+        if(new_size < HEAP_NONE) new_heap = lv_mem_realloc(heap, new_size * sizeof(lv_task_t *));
+        LV_ASSERT_MEM(new_heap);
+        if(new_heap == NULL) {
+            heap_err = true; /*The task still runs from the list but every call of the handler has to check it*/
+            return;
+        }
+        heap      = new_heap;
+        heap_size = new_size;
+    }
+
+    heap_set(heap_cnt, task);
+    heap_cnt++;
+    heap_sift_up(task->heap_id);
+}
+
+/**
+ * Remove a task from the heap if it's there
+ * @param task pointer to a task
+ */
+static void heap_rem(lv_task_t * task)
+{
+    uint16_t id = task->heap_id;
+    if(id == HEAP_NONE) return;
+
+    task->heap_id = HEAP_NONE;
+    heap_cnt--;
+    if(id == heap_cnt) return;
+
+    /*Put the last task to the free place and restore the order*/
+    heap_set(id, heap[heap_cnt]);
+    heap_update(heap[id]);
+}
+
+/**
+ * Restore the order of the heap after the time when a task is due has changed
+ * @param task pointer to a task
+ */
+static void heap_update(lv_task_t * task)
+{
+    uint16_t id = task->heap_id;
+    if(id == HEAP_NONE) return;
+
+    if(id > 0 && heap_before(task, heap[(id - 1) / 2])) heap_sift_up(id);
+    else heap_sift_down(id);
+}
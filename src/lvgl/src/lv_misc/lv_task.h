@@ -31,6 +31,11 @@ extern "C" {
 #ifndef LV_ATTRIBUTE_TASK_HANDLER
 #define LV_ATTRIBUTE_TASK_HANDLER
 #endif
+
+/**
+ * `lv_task_get_next_deadline()` returns it if there are no running tasks
+ */
+#define LV_TASK_NO_DEADLINE UINT32_MAX
 /**********************
  *      TYPEDEFS
  **********************/
@@ -67,6 +72,7 @@ typedef struct _lv_task_t
 
     void * user_data; /**< Custom user data */
 
+    uint16_t heap_id; /**< Position in the deadline heap (used internally) */
     uint8_t prio : 3; /**< Task priority */
     uint8_t once : 1; /**< 1: one shot task */
 } lv_task_t;
@@ -166,6 +172,13 @@ void lv_task_enable(bool en);
  */
 uint8_t lv_task_get_idle(void);
 
+/**
+ * Get the time until the next task is due.
+ * `lv_task_handler()` has nothing to do before it so the caller can sleep or wait for an event until then.
+ * @return time in ms, 0: a task is due now, `LV_TASK_NO_DEADLINE`: there are no running tasks
+ */
+uint32_t lv_task_get_next_deadline(void);
+
 /**********************
  *      MACROS
  **********************/
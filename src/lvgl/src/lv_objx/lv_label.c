@@ -41,6 +41,11 @@
 static lv_res_t lv_label_signal(lv_obj_t * label, lv_signal_t sign, void * param);
 static bool lv_label_design(lv_obj_t * label, const lv_area_t * mask, lv_design_mode_t mode);
 static void lv_label_refr_text(lv_obj_t * label);
+#if LV_LABEL_DIFF_INV
+static bool lv_label_inv_diff(lv_obj_t * label, const char * text);
+static uint16_t lv_label_diff_letters(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                      uint32_t * letters, lv_coord_t * pos_x);
+#endif
 static void lv_label_revert_dots(lv_obj_t * label);
 
 #if LV_USE_ANIMATION
@@ -56,6 +61,9 @@ static void lv_label_dot_tmp_free(lv_obj_t * label);
  *  STATIC VARIABLES
  **********************/
 static lv_signal_cb_t ancestor_signal;
+#if LV_LABEL_DIFF_INV
+static bool refr_inv_skip; /*The changed letters are already invalidated, don't invalidate the whole label*/
+#endif
 
 /**********************
  *      MACROS
@@ -176,10 +184,17 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
 {
     LV_ASSERT_OBJ(label, LV_OBJX_NAME);
 
-    lv_obj_invalidate(label);
-
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
 
+#if LV_LABEL_DIFF_INV
+    /*Invalidate only the letters which are different from the old text if possible*/
+    bool diff_inv = false;
+    if(text != NULL && ext->text != text) diff_inv = lv_label_inv_diff(label, text);
+    if(diff_inv == false) lv_obj_invalidate(label);
+#else
+    lv_obj_invalidate(label);
+#endif
+
     /*If text is NULL then refresh */
     if(text == NULL) {
         lv_label_refr_text(label);
@@ -211,7 +226,13 @@ void lv_label_set_text(lv_obj_t * label, const char * text)
         ext->static_txt = 0;
     }
 
+#if LV_LABEL_DIFF_INV
+    refr_inv_skip = diff_inv;
+    lv_label_refr_text(label);
+    refr_inv_skip = false;
+#else
     lv_label_refr_text(label);
+#endif
 }
 
 /**
@@ -1338,9 +1359,116 @@ static void lv_label_refr_text(lv_obj_t * label)
         /*Do nothing*/
     }
 
+#if LV_LABEL_DIFF_INV
+    if(refr_inv_skip) return;
+#endif
     lv_obj_invalidate(label);
 }
 
+#if LV_LABEL_DIFF_INV
+/**
+ * Invalidate the glyph boxes of the letters which are different in the new text.
+ * Works only if both texts are single line, have the same width and the label's size won't change.
+ * @param label pointer to a label object
+ * @param text the new text
+ * @return true: the changed letters are invalidated; false: the whole label needs to be invalidated
+ */
+static bool lv_label_inv_diff(lv_obj_t * label, const char * text)
+{
+    lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
+    if(ext->text == NULL || ext->recolor != 0 || ext->expand != 0) return false;
+    if(ext->offset.x != 0 || ext->offset.y != 0) return false;
+    if(ext->long_mode != LV_LABEL_LONG_EXPAND && ext->long_mode != LV_LABEL_LONG_BREAK &&
+       ext->long_mode != LV_LABEL_LONG_CROP) {
+        return false;
+    }
+
+    const lv_style_t * style = lv_obj_get_style(label);
+    const lv_font_t * font   = style->text.font;
+    lv_coord_t letter_space  = style->text.letter_space;
+
+    uint32_t old_letters[LV_LABEL_DIFF_MAX];
+    uint32_t new_letters[LV_LABEL_DIFF_MAX];
+    lv_coord_t old_x[LV_LABEL_DIFF_MAX + 1];
+    lv_coord_t new_x[LV_LABEL_DIFF_MAX + 1];
+    uint16_t old_cnt = lv_label_diff_letters(ext->text, font, letter_space, old_letters, old_x);
+    if(old_cnt == 0xFFFF) return false;
+    uint16_t new_cnt = lv_label_diff_letters(text, font, letter_space, new_letters, new_x);
+    if(new_cnt == 0xFFFF) return false;
+
+    /*Same width: the size and the alignment won't change*/
+    lv_coord_t w = old_x[old_cnt];
+    if(w != new_x[new_cnt]) return false;
+    if(ext->long_mode != LV_LABEL_LONG_EXPAND && w > lv_obj_get_width(label)) return false; /*Would wrap*/
+
+    lv_coord_t x_ofs = 0;
+    lv_label_align_t align = lv_label_get_align(label);
+    if(align == LV_LABEL_ALIGN_CENTER) x_ofs = (lv_obj_get_width(label) - w) / 2;
+    else if(align == LV_LABEL_ALIGN_RIGHT) x_ofs = lv_obj_get_width(label) - w;
+
+    uint16_t cnt = LV_MATH_MAX(old_cnt, new_cnt);
+    uint16_t i;
+    for(i = 0; i < cnt; i++) {
+        if(i < old_cnt && i < new_cnt && old_letters[i] == new_letters[i] && old_x[i] == new_x[i]) continue;
+
+        /*Invalidate the glyph box of the old and the new letter*/
+        uint8_t k;
+        for(k = 0; k < 2; k++) {
+            uint16_t letter_cnt = k == 0 ? old_cnt : new_cnt;
+            if(i >= letter_cnt) continue;
+            uint32_t letter = k == 0 ? old_letters[i] : new_letters[i];
+            uint32_t letter_next = i + 1 < letter_cnt ? (k == 0 ? old_letters[i + 1] : new_letters[i + 1]) : 0;
+            lv_font_glyph_dsc_t g;
+            if(lv_font_get_glyph_dsc(font, &g, letter, letter_next) == false) continue;
+            if(g.box_w == 0 || g.box_h == 0) continue;
+
+            lv_area_t box;
+            box.x1 = label->coords.x1 + x_ofs + (k == 0 ? old_x[i] : new_x[i]) + g.ofs_x;
+            box.x2 = box.x1 + g.box_w - 1;
+            box.y1 = label->coords.y1 + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+            box.y2 = box.y1 + g.box_h - 1;
+            lv_obj_invalidate_area(label, &box);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Get the letters of a single line text and their x position like `lv_draw_label` places them
+ * @param txt the text
+ * @param font font of the text
+ * @param letter_space letter space
+ * @param letters store the letters here (`LV_LABEL_DIFF_MAX` elements)
+ * @param pos_x store the x position of the letters here, the last element will be the width of the text
+ * @return number of letters or 0xFFFF if the text is too long or has more lines
+ */
+static uint16_t lv_label_diff_letters(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
+                                      uint32_t * letters, lv_coord_t * pos_x)
+{
+    uint32_t i = 0;
+    uint16_t cnt = 0;
+    lv_coord_t x = 0;
+    uint32_t letter = lv_txt_encoded_next(txt, &i);
+    while(letter != '\0') {
+        if(letter == '\n' || letter == '\r' || cnt >= LV_LABEL_DIFF_MAX) return 0xFFFF;
+        uint32_t i_next = i;
+        uint32_t letter_next = lv_txt_encoded_next(txt, &i_next);
+        letters[cnt] = letter;
+        pos_x[cnt] = x;
+        cnt++;
+        lv_coord_t letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        if(letter_w > 0) x += letter_w + letter_space;
+        i = i_next;
+        letter = letter_next;
+    }
+
+    if(x > 0) x -= letter_space; /*Trim the last letter space like `lv_txt_get_width`*/
+    pos_x[cnt] = x;
+    return cnt;
+}
+#endif
+
 static void lv_label_revert_dots(lv_obj_t * label)
 {
     lv_label_ext_t * ext = lv_obj_get_ext_attr(label);
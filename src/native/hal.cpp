@@ -0,0 +1,70 @@
+/**********************
+    Native env stand ins for the sketch's hardware side: no speed input, gps, timers or touch controller.
+    Settings and screens are the real ones from screens.cpp.
+ **********************/
+#include <time.h>
+#include "app.h"
+#include <EEPROM.h>
+#include <SPIFFS.h>
+#include <TFT_eSPI.h>
+
+#define CALIBRATION_FILE "/TouchCalData2"           //same file the sketch keeps the touch calibration in
+
+HardwareSerial Serial;
+EspClass ESP;
+EEPROMClass EEPROM;
+fs::FS SPIFFS;
+TFT_eSPI tft = TFT_eSPI();                          //framebuffer and scripted touch
+
+bool REPEAT_CAL;                                    //set by the factory screen to calibrate the touch screen again
+int var_REPEAT_CAL;
+long old_millis;
+bool field_calibration_flag;
+volatile bool filter_reset_request;
+uint32_t refr_last_px;                              //pixels of the newest redraw (monitor_cb in main.cpp)
+
+unsigned long micros(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+unsigned long millis(void) {
+  return micros() / 1000;
+}
+void delay(unsigned long ms) {
+  struct timespec ts = {(time_t)(ms / 1000), (long)(ms % 1000) * 1000000};
+  nanosleep(&ts, NULL);
+}
+
+/* Strips are in the framebuffer when my_disp_flush returns, nothing is ever on the way */
+void flush_wait(void) {
+}
+void calculate_speed_constant(void) {               //no speed input, the screens only show what the scenarios send
+}
+void enable_gps(void) {
+}
+void enable_radar(void) {
+}
+void set_gate_timer(void) {
+}
+uint32_t field_pulse_count(void) {                  //field calibration run with no pulses
+  return 0;
+}
+void field_pulse_reset(void) {
+}
+void touch_calibrate() {                            //keeps the calibration file like the sketch, there is nothing to calibrate
+  uint16_t calData[5] = {300, 3500, 300, 3500, 7};  //raw touch range, rotation 1
+  flush_wait();
+  if (REPEAT_CAL == false && SPIFFS.exists(CALIBRATION_FILE)) {
+    File f = SPIFFS.open(CALIBRATION_FILE, "r");
+    f.readBytes((char *)calData, sizeof(calData));
+    f.close();
+    }
+  else {
+    File f = SPIFFS.open(CALIBRATION_FILE, "w");
+    f.write((const unsigned char *)calData, sizeof(calData));
+    f.close();
+    REPEAT_CAL = false;
+    }
+  tft.setTouch(calData);
+}
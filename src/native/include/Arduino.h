@@ -0,0 +1,78 @@
+/**********************
+    Arduino core for the native env, only what screens.cpp and scenarios.cpp use.
+    Serial prints to stdout, millis() and micros() come from the host clock.
+ **********************/
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <string>
+
+#define IRAM_ATTR
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+class String {
+public:
+  String(const char * c = "") : s(c) {}
+  String(const std::string & c) : s(c) {}
+  String operator+(const String & o) const { return String(s + o.s); }
+  String operator+(const char * o) const { return String(s + o); }
+  friend String operator+(const char * a, const String & b) { return String(std::string(a) + b.s); }
+  bool operator==(const String & o) const { return s == o.s; }
+  bool operator==(const char * o) const { return s == o; }
+  bool operator!=(const String & o) const { return s != o.s; }
+  bool operator!=(const char * o) const { return s != o; }
+  long toInt(void) const { return atol(s.c_str()); }
+  float toFloat(void) const { return (float)atof(s.c_str()); }
+  unsigned int length(void) const { return (unsigned int)s.size(); }
+  void remove(unsigned int index, unsigned int count) { s.erase(index, count); }
+  const char * c_str(void) const { return s.c_str(); }
+private:
+  std::string s;
+};
+
+class Print {
+public:
+  size_t print(const char * t) { return (size_t)::printf("%s", t); }
+  size_t print(const String & t) { return print(t.c_str()); }
+  size_t print(char c) { return (size_t)::printf("%c", c); }
+  size_t print(int n) { return (size_t)::printf("%d", n); }
+  size_t print(unsigned int n) { return (size_t)::printf("%u", n); }
+  size_t print(long n) { return (size_t)::printf("%ld", n); }
+  size_t print(unsigned long n) { return (size_t)::printf("%lu", n); }
+  size_t print(double n) { return (size_t)::printf("%.2f", n); }
+  size_t println(void) { return (size_t)::printf("\n"); }
+  template<typename T> size_t println(T t) { size_t n = print(t); return n + println(); }
+  size_t printf(const char * format, ...) __attribute__((format(printf, 2, 3))) {
+    va_list args;
+    va_start(args, format);
+    int n = vprintf(format, args);
+    va_end(args);
+    return n > 0 ? (size_t)n : 0;
+  }
+};
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud) { (void)baud; }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+};
+extern HardwareSerial Serial;
+
+class EspClass {
+public:
+  void restart(void) { ::printf("ESP.restart()\n"); }          //factory screen reset button, nothing to restart
+};
+extern EspClass ESP;
+
+#endif
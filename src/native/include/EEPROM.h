@@ -0,0 +1,32 @@
+/**********************
+    EEPROM for the native env, kept in memory. Starts erased (0xFF) like a new esp32.
+ **********************/
+#ifndef NATIVE_EEPROM_H
+#define NATIVE_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define native_eeprom_size 512
+
+class EEPROMClass {
+public:
+  EEPROMClass() { memset(data, 0xFF, sizeof(data)); }
+  bool begin(size_t size) { return size <= sizeof(data); }
+  template<typename T> T & get(int address, T & t) {
+    memcpy(&t, data + address, sizeof(T));
+    return t;
+  }
+  template<typename T> const T & put(int address, const T & t) {
+    memcpy(data + address, &t, sizeof(T));
+    return t;
+  }
+  uint8_t read(int address) { return data[address]; }
+  void write(int address, uint8_t value) { data[address] = value; }
+  bool commit(void) { return true; }
+private:
+  uint8_t data[native_eeprom_size];
+};
+extern EEPROMClass EEPROM;
+
+#endif
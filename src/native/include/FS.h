@@ -0,0 +1,57 @@
+/**********************
+    File system for the native env, files are kept in memory for the life of the program.
+ **********************/
+#ifndef NATIVE_FS_H
+#define NATIVE_FS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+
+namespace fs {
+
+class File {
+public:
+  File(std::string * data = NULL) : data(data), pos(0) {}
+  operator bool() const { return data != NULL; }
+  size_t readBytes(char * buffer, size_t length) {
+    size_t n = data->size() - pos < length ? data->size() - pos : length;
+    data->copy(buffer, n, pos);
+    pos = pos + n;
+    return n;
+  }
+  size_t write(const uint8_t * buffer, size_t size) {
+    data->append((const char *)buffer, size);
+    return size;
+  }
+  void close(void) { data = NULL; }
+private:
+  std::string * data;
+  size_t pos;
+};
+
+class FS {
+public:
+  bool begin(void) { return true; }
+  bool format(void) { files.clear(); return true; }
+  bool exists(const char * path) { return files.count(path) != 0; }
+  bool remove(const char * path) { return files.erase(path) != 0; }
+  File open(const char * path, const char * mode) {
+    if (mode[0] == 'w') {
+      files[path].clear();
+      }
+    else if (exists(path) == false) {
+      return File();
+      }
+    return File(&files[path]);
+  }
+private:
+  std::map<std::string, std::string> files;
+};
+
+}
+
+using fs::File;
+
+#endif
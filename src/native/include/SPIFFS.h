@@ -0,0 +1,11 @@
+/**********************
+    SPIFFS for the native env (in memory, see FS.h)
+ **********************/
+#ifndef NATIVE_SPIFFS_H
+#define NATIVE_SPIFFS_H
+
+#include "FS.h"
+
+extern fs::FS SPIFFS;
+
+#endif
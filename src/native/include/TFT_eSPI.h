@@ -0,0 +1,63 @@
+/**********************
+    TFT_eSPI for the native env. The display is a 480x320 RGB565 framebuffer in memory and
+    getTouch() returns the point set by the scripted input (src/native/main.cpp).
+ **********************/
+#ifndef NATIVE_TFT_ESPI_H
+#define NATIVE_TFT_ESPI_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define TFT_WIDTH 480
+#define TFT_HEIGHT 320
+
+class TFT_eSPI {
+public:
+  uint16_t fb[TFT_HEIGHT][TFT_WIDTH];              //what is on the screen, RGB565
+  uint16_t touch_x, touch_y;                       //scripted touch point
+  bool touch_pressed;
+
+  TFT_eSPI() : touch_x(0), touch_y(0), touch_pressed(false), win_x1(0), win_y1(0), win_x2(0), win_y2(0), pos_x(0), pos_y(0) {
+    memset(fb, 0, sizeof(fb));
+  }
+  void init(void) {}
+  void setRotation(uint8_t r) { (void)r; }
+  void startWrite(void) {}
+  void endWrite(void) {}
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+    win_x1 = x;
+    win_y1 = y;
+    win_x2 = x + w - 1;
+    win_y2 = y + h - 1;
+    pos_x = x;
+    pos_y = y;
+  }
+  void pushColors(const uint16_t * data, uint32_t len, bool swap = true) {   //swap only changes the byte order on the spi bus
+    (void)swap;
+    for (uint32_t i = 0; i < len; i++) {
+      if (pos_x >= 0 && pos_x < TFT_WIDTH && pos_y >= 0 && pos_y < TFT_HEIGHT) {
+        fb[pos_y][pos_x] = data[i];
+        }
+      pos_x = pos_x + 1;
+      if (pos_x > win_x2) {                        //next row of the window
+        pos_x = win_x1;
+        pos_y = pos_y + 1;
+        }
+      }
+  }
+  uint8_t getTouch(uint16_t * x, uint16_t * y, uint16_t threshold = 600) {
+    (void)threshold;
+    if (touch_pressed == false) {
+      return false;
+      }
+    *x = touch_x;
+    *y = touch_y;
+    return true;
+  }
+  void setTouch(uint16_t * data) { (void)data; }
+private:
+  int32_t win_x1, win_y1, win_x2, win_y2;
+  int32_t pos_x, pos_y;
+};
+
+#endif
@@ -0,0 +1,324 @@
+/**********************
+    Native env (pio run -e native): the real screens and lvgl on a 480x320 RGB565 framebuffer.
+    Runs the render scenarios of serial 's' (speed ramp, screen switches, message boxes) and a
+    scripted touch run through the setup button, options and calibrate screens, then prints
+    ms and pixels per frame like the esp32 does, and the lvgl heap use like serial 'p'.
+
+    program [-S] [--png dir]
+      -S         also print a checksum of every frame (same as serial 'S')
+      --png dir  write the framebuffer after every frame to dir/<scenario>_<frame>.png
+ **********************/
+#ifndef PIO_UNIT_TESTING
+#include <stdio.h>
+#include <string.h>
+#include "app.h"
+#include <EEPROM.h>
+#include <TFT_eSPI.h>
+
+#define LVGL_TICK_PERIOD 10                         //ms per lv_tick_inc() in the touch script
+#define touch_press_ms 100                          //how long the script holds a press
+#define touch_release_ms 300                        //and waits after letting go
+
+extern TFT_eSPI tft;
+
+static lv_disp_buf_t disp_buf;
+static lv_color_t buf[LV_HOR_RES_MAX * 10];         //one buffer, a strip is in the framebuffer when flush returns
+static uint32_t refr_frames;                        //redraws since the last touch step (monitor_cb)
+static uint32_t refr_px;
+static uint32_t refr_visits;
+static const char * png_dir;                        //--png
+
+/* Send a strip to the framebuffer */
+void my_disp_flush(lv_disp_drv_t * disp, const lv_area_t * area, lv_color_t * color_p) {
+  uint32_t w = area->x2 - area->x1 + 1;
+  uint32_t h = area->y2 - area->y1 + 1;
+  if (scen_hash_on) {
+    scen_hash = frame_hash(scen_hash, area, color_p, w * h);
+    }
+  tft.setAddrWindow(area->x1, area->y1, w, h);
+  tft.pushColors(&color_p->full, w * h, true);
+  lv_disp_flush_ready(disp);
+}
+/* Called by lvgl after each refresh with the time used and the pixels redrawn */
+void my_disp_monitor(lv_disp_drv_t * disp, uint32_t time, uint32_t px) {
+  (void)disp;
+  (void)time;
+  refr_last_px = px;
+  refr_frames = refr_frames + 1;
+  refr_px = refr_px + px;
+  refr_visits = refr_visits + lv_refr_get_obj_visits();
+}
+bool my_input_read(lv_indev_drv_t * drv, lv_indev_data_t * data) {
+  (void)drv;
+  uint16_t t_x = 0, t_y = 0;
+  static int16_t last_x = 0;
+  static int16_t last_y = 0;
+  if (tft.getTouch(&t_x, &t_y)) {
+    last_x = t_x;
+    last_y = t_y;
+    data->state = LV_INDEV_STATE_PR;
+    }
+  else {
+    data->state = LV_INDEV_STATE_REL;
+    }
+  data->point.x = last_x;
+  data->point.y = last_y;
+  return false;
+}
+/**********************
+    PNG dumps, 8 bit RGB with stored (uncompressed) deflate blocks
+ **********************/
+static uint32_t png_crc(uint32_t crc, const uint8_t * p, size_t n) {
+  crc = ~crc;
+  for (size_t i = 0; i < n; i++) {
+    crc = crc ^ p[i];
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+      }
+    }
+  return ~crc;
+}
+static void png_put32(uint8_t * p, uint32_t v) {
+  p[0] = v >> 24;
+  p[1] = v >> 16;
+  p[2] = v >> 8;
+  p[3] = v;
+}
+static void png_chunk(FILE * f, const char * type, const uint8_t * data, uint32_t n) {
+  uint8_t word[4];
+  png_put32(word, n);
+  fwrite(word, 1, 4, f);
+  fwrite(type, 1, 4, f);
+  fwrite(data, 1, n, f);
+  uint32_t crc = png_crc(0, (const uint8_t *)type, 4);
+  png_put32(word, png_crc(crc, data, n));
+  fwrite(word, 1, 4, f);
+}
+static bool png_write(const char * path) {
+  const uint32_t row = 1 + TFT_WIDTH * 3;                                        //filter byte + rgb
+  const uint32_t raw_n = row * TFT_HEIGHT;
+  static uint8_t raw[(1 + TFT_WIDTH * 3) * TFT_HEIGHT];
+  static uint8_t z[(1 + TFT_WIDTH * 3) * TFT_HEIGHT + ((1 + TFT_WIDTH * 3) * TFT_HEIGHT / 65535 + 1) * 5 + 6];
+  for (uint32_t y = 0; y < TFT_HEIGHT; y++) {
+    uint8_t * p = raw + y * row;
+    *p++ = 0;                                                                    //no filter
+    for (uint32_t x = 0; x < TFT_WIDTH; x++) {
+      uint16_t c = tft.fb[y][x];
+      *p++ = ((c >> 11) & 0x1F) * 255 / 31;
+      *p++ = ((c >> 5) & 0x3F) * 255 / 63;
+      *p++ = (c & 0x1F) * 255 / 31;
+      }
+    }
+  uint32_t n = 0;
+  z[n++] = 0x78;                                                                 //zlib header, no compression
+  z[n++] = 0x01;
+  uint32_t a = 1, b = 0;
+  for (uint32_t i = 0; i < raw_n; i++) {
+    a = (a + raw[i]) % 65521;
+    b = (b + a) % 65521;
+    }
+  for (uint32_t pos = 0; pos < raw_n; ) {
+    uint32_t len = (raw_n - pos > 65535) ? 65535 : raw_n - pos;
+    z[n++] = (pos + len == raw_n) ? 1 : 0;                                       //last block flag, stored
+    z[n++] = len;
+    z[n++] = len >> 8;
+    z[n++] = ~len;
+    z[n++] = (~len) >> 8;
+    memcpy(z + n, raw + pos, len);
+    n = n + len;
+    pos = pos + len;
+    }
+  png_put32(z + n, (b << 16) | a);
+  n = n + 4;
+
+  FILE * f = fopen(path, "wb");
+  if (f == NULL) {
+    return false;
+    }
+  static const uint8_t sig[8] = {0x89, 'P', 'N', 'G', 0x0D, 0x0A, 0x1A, 0x0A};
+  uint8_t ihdr[13];
+  png_put32(ihdr, TFT_WIDTH);
+  png_put32(ihdr + 4, TFT_HEIGHT);
+  ihdr[8] = 8;                                                                   //bit depth
+  ihdr[9] = 2;                                                                   //rgb
+  ihdr[10] = 0;
+  ihdr[11] = 0;
+  ihdr[12] = 0;
+  fwrite(sig, 1, 8, f);
+  png_chunk(f, "IHDR", ihdr, 13);
+  png_chunk(f, "IDAT", z, n);
+  png_chunk(f, "IEND", NULL, 0);
+  fclose(f);
+  return true;
+}
+/* scen_frame_cb, framebuffer to <png_dir>/<scenario>_<frame>.png */
+static void png_frame(const char * name, uint32_t frame) {
+  char path[256];
+  int n = snprintf(path, sizeof(path), "%s/", png_dir);
+  for (const char * c = name; *c != 0 && n < (int)sizeof(path) - 16; c++) {
+    path[n++] = (*c == ' ') ? '_' : *c;
+    }
+  snprintf(path + n, sizeof(path) - n, "_%03u.png", (unsigned)frame);
+  if (png_write(path) == false) {
+    fprintf(stderr, "can't write %s\n", path);
+    }
+}
+/**********************
+    Scripted touch
+ **********************/
+/* Center of an object on the screen */
+static lv_point_t obj_center(lv_obj_t * obj) {
+  lv_area_t a;
+  lv_obj_get_coords(obj, &a);
+  lv_point_t p = {(lv_coord_t)((a.x1 + a.x2) / 2), (lv_coord_t)((a.y1 + a.y2) / 2)};
+  return p;
+}
+/* Center of the message box button with this text */
+static lv_point_t mbox_btn_center(lv_obj_t * mbox, const char * text) {
+  lv_mbox_ext_t * mext = (lv_mbox_ext_t *)lv_obj_get_ext_attr(mbox);
+  lv_btnm_ext_t * ext = (lv_btnm_ext_t *)lv_obj_get_ext_attr(mext->btnm);
+  lv_area_t btnm;
+  lv_obj_get_coords(mext->btnm, &btnm);
+  lv_point_t p = {0, 0};
+  uint16_t b = 0;
+  for (uint16_t i = 0; ext->map_p[i][0] != 0; i++) {
+    if (strcmp(ext->map_p[i], "\n") == 0) {                                      //row break, not a button
+      continue;
+      }
+    if (strcmp(ext->map_p[i], text) == 0) {
+      const lv_area_t * a = &ext->button_areas[b];
+      p.x = btnm.x1 + (a->x1 + a->x2) / 2;
+      p.y = btnm.y1 + (a->y1 + a->y2) / 2;
+      break;
+      }
+    b++;
+    }
+  return p;
+}
+/* Let lvgl run for ms, only the lvgl calls are timed */
+static void touch_run(scen_stats * st, uint32_t ms) {
+  for (uint32_t t = 0; t < ms; t = t + LVGL_TICK_PERIOD) {
+    lv_tick_inc(LVGL_TICK_PERIOD);
+    refr_frames = 0;
+    refr_px = 0;
+    refr_visits = 0;
+    uint32_t start = micros();
+    lv_task_handler();
+    uint32_t us = micros() - start;
+    if (refr_frames == 0) {                                                      //nothing redrawn, not a frame
+      continue;
+      }
+    st->frames = st->frames + refr_frames;
+    st->us = st->us + us;
+    st->px = st->px + refr_px;
+    st->visits = st->visits + refr_visits;
+    if (us > st->us_max) {
+      st->us_max = us;
+      }
+    if (scen_frame_cb != NULL) {
+      scen_frame_cb(st->name, st->frames);
+      }
+    }
+}
+/* Press and let go of a point like a finger would */
+static void touch_tap(scen_stats * st, lv_point_t p) {
+  tft.touch_x = p.x;
+  tft.touch_y = p.y;
+  tft.touch_pressed = true;
+  touch_run(st, touch_press_ms);
+  tft.touch_pressed = false;
+  touch_run(st, touch_release_ms);
+}
+/* Setup button, options (change units and back), calibrate screen and back, message box closed */
+static void touch_script(void) {
+  scen_stats settle = {};                                                        //let the run screen finish drawing first
+  settle.name = "touch settle";
+  screen_run_on();
+  touch_run(&settle, touch_release_ms);
+
+  scen_stats st = {};
+  st.name = "touch";
+
+  touch_tap(&st, obj_center(btn_setup));
+  touch_tap(&st, mbox_btn_center(mbox1, "Options"));
+  touch_tap(&st, obj_center(cb_kph));
+  touch_tap(&st, obj_center(cb_mph));
+  touch_tap(&st, obj_center(btn_set_exit));
+  touch_tap(&st, obj_center(btn_setup));
+  touch_tap(&st, mbox_btn_center(mbox1, "Calibrate"));
+  touch_tap(&st, obj_center(btn_exit));
+  touch_tap(&st, obj_center(btn_setup));
+  touch_tap(&st, mbox_btn_center(mbox1, "Close"));
+  scen_print(&st);
+}
+/* Settings the sketch would load from eeprom, fixed so every run draws the same screens */
+static void settings_defaults(void) {
+  units = 1;                                                                     //mph
+  security = 0;
+  dis = 1;
+  graph = 1;
+  alarm_enable = 0;
+  fpm = 1;
+  speed_avg = filter_none;
+  speed_input = 0;                                                               //radar, calibrate screen is used
+  speed_mode = 0;
+  speed_target = 30.0;
+  cal_number = 1000;
+  old_cal_number = cal_number;
+  ALR1 = 1.0;
+  ALR2 = 2.0;
+  ALR3 = 3.0;
+  ALR4 = 4.0;
+  user_passcode = "1234E";
+  var_REPEAT_CAL = 55;
+  REPEAT_CAL = false;
+}
+
+int main(int argc, char ** argv) {
+  bool hash = false;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-S") == 0) {
+      hash = true;
+      }
+    else if (strcmp(argv[i], "--png") == 0 && i + 1 < argc) {
+      png_dir = argv[++i];
+      scen_frame_cb = png_frame;
+      }
+    else {
+      fprintf(stderr, "usage: %s [-S] [--png dir]\n", argv[0]);
+      return 2;
+      }
+    }
+  lv_init();
+  EEPROM.begin(200);
+  tft.init();
+  tft.setRotation(1);
+  lv_disp_buf_init(&disp_buf, buf, NULL, LV_HOR_RES_MAX * 10);
+  lv_disp_drv_t disp_drv;
+  lv_disp_drv_init(&disp_drv);
+  disp_drv.hor_res = TFT_WIDTH;
+  disp_drv.ver_res = TFT_HEIGHT;
+  disp_drv.flush_cb = my_disp_flush;
+  disp_drv.monitor_cb = my_disp_monitor;
+  disp_drv.buffer = &disp_buf;
+  lv_disp_drv_register(&disp_drv);
+  lv_indev_drv_t indev_drv;
+  lv_indev_drv_init(&indev_drv);
+  indev_drv.type = LV_INDEV_TYPE_POINTER;
+  indev_drv.read_cb = my_input_read;
+  lv_indev_drv_register(&indev_drv);
+
+  settings_defaults();
+  calculate_speed_constant();
+  touch_calibrate();
+  build_screens();
+
+  scen_run(hash);
+  touch_script();
+  lv_mem_monitor_t mon;
+  lv_mem_monitor(&mon);                                                          //heap line of serial 'p'
+  printf("lvgl heap  used %u%% max %u of %u  biggest free %u frag %u%%\n", (unsigned)mon.used_pct,
+         (unsigned)mon.max_used, (unsigned)mon.total_size, (unsigned)mon.free_biggest_size, (unsigned)mon.frag_pct);
+  return 0;
+}
+#endif
@@ -0,0 +1,127 @@
+/**************************
+   Render scenarios (serial 's', 'S' also prints a checksum of every frame to compare against a known good run)
+   fixed sequences of speed readings and screen changes, each frame drawn with lv_refr_now()
+   the same scenarios run on the native env (src/native) against an in memory framebuffer
+ **************************/
+#include "app.h"
+
+volatile bool scen_hash_on;                         //flush adds every strip to scen_hash
+uint32_t scen_hash;                                 //checksum of the strips sent for the current frame
+void (*scen_frame_cb)(const char * name, uint32_t frame);   //called after every frame (native env writes png files)
+/* FNV-1a over the strip position and pixels, strips arrive in the same order every run */
+uint32_t frame_hash(uint32_t hash, const lv_area_t * area, const lv_color_t * color_p, uint32_t n) {
+  hash = (hash ^ (uint32_t)(area->x1 | (area->y1 << 16))) * 16777619UL;
+  const uint16_t * p = (const uint16_t *)color_p;
+  for (uint32_t i = 0; i < n; i++) {
+    hash = (hash ^ p[i]) * 16777619UL;
+    }
+  return hash;
+}
+/* Draw one scenario frame now and add it to the totals */
+void scen_frame(scen_stats * st) {
+  refr_last_px = 0;
+  scen_hash = 2166136261UL;
+  uint32_t start = micros();
+  lv_refr_now(NULL);                                                             //draw and send every strip now
+  flush_wait();                                                                  //last strip may still be on the way
+  uint32_t us = micros() - start;
+  st->frames++;
+  st->us = st->us + us;
+  st->px = st->px + refr_last_px;
+  st->visits = st->visits + lv_refr_get_obj_visits();
+  if (us > st->us_max) {
+    st->us_max = us;
+    }
+  if (scen_hash_on) {
+    Serial.printf("  %s %u %08x\n", st->name, (unsigned)st->frames, (unsigned)scen_hash);
+    }
+  if (scen_frame_cb != NULL) {
+    scen_frame_cb(st->name, st->frames);
+    }
+}
+void scen_print(const scen_stats * st) {
+  uint32_t avg = (st->frames > 0) ? st->us / st->frames : 0;
+  Serial.printf("%-14s %3u frames %u.%ums/frame max %u.%ums %upx/frame %u objects/frame\n", st->name, (unsigned)st->frames,
+                (unsigned)(avg / 1000), (unsigned)((avg / 100) % 10),
+                (unsigned)(st->us_max / 1000), (unsigned)((st->us_max / 100) % 10),
+                (unsigned)(st->frames > 0 ? st->px / st->frames : 0),
+                (unsigned)(st->frames > 0 ? st->visits / st->frames : 0));
+}
+/* Serial 's'/'S', run the render scenarios and print ms and pixels per frame */
+void scen_run(bool hash) {
+  scen_hash_on = hash;
+  screen_run_on();                                                               //every scenario starts from the run screen
+  lv_obj_invalidate(lv_scr_act());
+  lv_refr_now(NULL);
+  flush_wait();
+
+  scen_stats ramp = {};                                                          //0 to 60 and back in 0.5 steps
+  ramp.name = "speed ramp";
+  speed_sample sample;
+  sample.gps_status = gps_locked;
+  for (int16_t i = -120; i <= 120; i++) {
+    sample.time = micros();
+    sample.mph_q16 = (120 - abs(i)) * 32768;
+    sample.disp_q16 = sample.mph_q16;
+    show_speed(&sample);
+    scen_frame(&ramp);
+    }
+  scen_print(&ramp);
+
+  scen_stats screens = {};                                                       //same calls as the screen buttons
+  screens.name = "screen switch";
+  for (uint8_t n = 0; n < 3; n++) {
+    screen_run_off();
+    option_screen_on();
+    scen_frame(&screens);
+    option_screen_off();
+    screen_target_on();
+    scen_frame(&screens);
+    screen_target_off();
+    option_screen_on();
+    scen_frame(&screens);
+    option_screen_off();
+    screen_calibrate_on();
+    scen_frame(&screens);
+    field_calibrate_on();
+    scen_frame(&screens);
+    field_calibrate_off();
+    screen_calibrate_on();
+    scen_frame(&screens);
+    screen_calibrate_off();
+    screen_factory_on();
+    scen_frame(&screens);
+    screen_factory_off();
+    screen_run_on();
+    scen_frame(&screens);
+    }
+  scen_print(&screens);
+
+  scen_stats alarm = {};                                                         //alarm button on the run screen, then exit
+  alarm.name = "alarm set";
+  for (uint8_t n = 0; n < 5; n++) {
+    set_alarm_cb(btn_show_alarms, LV_EVENT_PRESSED);
+    scen_frame(&alarm);
+    set_alarm_cb(btn_alarm_set_exit, LV_EVENT_PRESSED);
+    scen_frame(&alarm);
+    }
+  scen_print(&alarm);
+
+  scen_stats mbox = {};                                                          //setup message box open and closed
+  mbox.name = "message box";
+  for (uint8_t n = 0; n < 5; n++) {
+    lv_ex_mbox_1();
+    lv_obj_set_hidden(option_descrip_text, false);
+    lv_obj_set_hidden(calibrate_descrip_text, false);
+    lv_obj_set_hidden(close_descrip_text, false);
+    scen_frame(&mbox);
+    lv_obj_del(mbox1);
+    lv_obj_set_hidden(option_descrip_text, true);
+    lv_obj_set_hidden(calibrate_descrip_text, true);
+    lv_obj_set_hidden(close_descrip_text, true);
+    screen_run_on();
+    scen_frame(&mbox);
+    }
+  scen_print(&mbox);
+  scen_hash_on = false;
+}
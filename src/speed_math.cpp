@@ -0,0 +1,237 @@
+/**********************
+    Fixed point speed math (see speed_math.h)
+ **********************/
+#include <math.h>
+#include "speed_math.h"
+
+uint64_t speed_q_for_cal(int cal) {                                                 //fixed point speed constant for a calibration number
+  if (cal <= 0) {
+    return 0;
+    }
+  uint64_t den = 176ULL * (uint64_t)cal;
+  return (65536ULL * 1000000ULL * 36000ULL + den / 2) / den;                        //65536 x 1000000us / (cal x 17.6 / 3600), rounded
+}
+uint32_t round_q16(uint64_t n) {                                                    //Q16 to whole number, ties to even (same as printf)
+  uint32_t whole = (uint32_t)(n >> 16);
+  uint32_t rem = (uint32_t)(n & 0xFFFF);
+  if (rem > 0x8000 || (rem == 0x8000 && (whole & 1))) {
+    whole = whole + 1;
+    }
+  return whole;
+}
+void format_speed(char * buf, int32_t q) {                                          //same text as "%4.1f" (50 and under) or "%4.0f" (over 50) without printf
+  char digits[12];
+  int len = 0;
+  uint32_t n;
+  if (q < 0) {
+    q = 0;
+    }
+  if (q <= (50L << 16)) {                                                           //tenths for speeds of 50 and under
+    n = round_q16((uint64_t)q * 10);
+    digits[len++] = '0' + n % 10;
+    n = n / 10;
+    digits[len++] = '.';
+    }
+  else {
+    n = round_q16((uint64_t)q);
+    }
+  do {                                                                              //whole number digits, least significant first
+    digits[len++] = '0' + n % 10;
+    n = n / 10;
+    } while (n != 0);
+  int pos = 0;
+  for (int pad = len; pad < 4; pad++) {                                             //right justify in 4 characters
+    buf[pos++] = ' ';
+    }
+  while (len > 0) {
+    buf[pos++] = digits[--len];
+    }
+  buf[pos] = 0;
+}
+void format_uint(char * buf, uint32_t n) {                                          //unsigned number to text without printf
+  char digits[12];
+  int len = 0;
+  do {
+    digits[len++] = '0' + n % 10;
+    n = n / 10;
+    } while (n != 0);
+  while (len > 0) {
+    *buf++ = digits[--len];
+    }
+  *buf = 0;
+}
+
+int32_t gate_speed_q16(uint32_t pulses, uint64_t q_const, uint32_t time_us) {     //pulses per second / pulses per second at 1 mph
+  if (time_us == 0) {
+    return 0;
+    }
+  return (int32_t)(((uint64_t)pulses * q_const + time_us / 2) / time_us);
+}
+
+/**********************
+    speed filters
+ **********************/
+static kalman_gain kalman_table[kalman_buckets];   //gains for readings kalman_bucket_us x 2^i apart
+
+static int32_t sat_q16(int64_t n) {                                                 //keep a 64 bit result in int32
+  if (n > INT32_MAX) {
+    return INT32_MAX;
+    }
+  if (n < INT32_MIN) {
+    return INT32_MIN;
+    }
+  return (int32_t)n;
+}
+void kalman_solve(float dt, kalman_gain * g) {                                      //iterate the riccati equation until the gains settle
+  float p[3][3] = {{0,0,0},{0,0,0},{0,0,0}};                                        //constant acceleration model, state = speed, rate, acceleration
+  float q[3][3] = {{dt*dt*dt*dt*dt/20, dt*dt*dt*dt/8, dt*dt*dt/6},
+                   {dt*dt*dt*dt/8,     dt*dt*dt/3,    dt*dt/2},
+                   {dt*dt*dt/6,        dt*dt/2,       dt}};
+  float f[3][3] = {{1, dt, dt*dt/2}, {0, 1, dt}, {0, 0, 1}};
+  float k[3] = {1, 0, 0};
+  for (int n = 0; n < kalman_iterations; n++) {
+    float fp[3][3];
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        fp[i][j] = f[i][0]*p[0][j] + f[i][1]*p[1][j] + f[i][2]*p[2][j];
+    for (int i = 0; i < 3; i++)                                                     //predict P = F P F' + Q
+      for (int j = 0; j < 3; j++)
+        p[i][j] = fp[i][0]*f[j][0] + fp[i][1]*f[j][1] + fp[i][2]*f[j][2] + kalman_q*q[i][j];
+    float s = p[0][0] + kalman_r;                                                   //update, only speed is measured
+    bool settled = n > 2;
+    for (int i = 0; i < 3; i++) {
+      float ki = p[i][0] / s;
+      float change = ki - k[i];
+      if (change > 1e-6f * ki || change < -1e-6f * ki) {
+        settled = false;
+        }
+      k[i] = ki;
+      }
+    float row0[3] = {p[0][0], p[0][1], p[0][2]};
+    for (int i = 0; i < 3; i++)
+      for (int j = 0; j < 3; j++)
+        p[i][j] = p[i][j] - k[i]*row0[j];
+    if (settled) {
+      break;
+      }
+    }
+  g->k1 = (int32_t)(k[0] * 65536);
+  g->k2 = (int32_t)(k[1] * 65536);
+  g->k3 = (int32_t)(k[2] * 65536);
+}
+float kalman_noise_ratio(float dt, const kalman_gain * g) {                         //square root of the sum of squares of the response to one reading
+  float k[3] = {(float)g->k1 / 65536, (float)g->k2 / 65536, (float)g->k3 / 65536};
+  float s[3] = {k[0], k[1], k[2]};                                                  //state after a reading of 1
+  double sum = 0;
+  for (int n = 0; n < kalman_iterations * 4; n++) {
+    sum = sum + (double)s[0] * s[0];
+    float xp = s[0] + s[1] * dt + s[2] * dt * dt / 2;                               //predict, then update with a reading of 0
+    float vp = s[1] + s[2] * dt;
+    s[0] = xp - k[0] * xp;
+    s[1] = vp - k[1] * xp;
+    s[2] = s[2] - k[2] * xp;
+    }
+  return (float)sqrt(sum);
+}
+void speed_filter_init(void) {                                                      //gains for every bucket, readings come 1ms (per pulse) to 1s (adaptive gate) apart
+  for (int i = 0; i < kalman_buckets; i++) {
+    float dt = (float)((uint32_t)kalman_bucket_us << i) / 1000000;
+    kalman_solve(dt, &kalman_table[i]);
+    if (kalman_noise_ratio(dt, &kalman_table[i]) > kalman_pass_ratio) {            //the model lets the speed move so far between readings that
+      kalman_table[i].k1 = 65536;                                                   //the gains hardly filter and timing jitter makes it worse,
+      kalman_table[i].k2 = 0;                                                       //take the readings as they are (512ms and 1s)
+      kalman_table[i].k3 = 0;
+      }
+    }
+}
+const kalman_gain * kalman_gain_for(int32_t dt_us) {                               //nearest bucket, the bucket edges are at x 1.414 of a bucket
+  int i = 0;
+  while (i < kalman_buckets - 1 && (int64_t)dt_us * 1000 > (int64_t)kalman_bucket_us * 1414 << i) {
+    i = i + 1;
+    }
+  return &kalman_table[i];
+}
+void speed_filter_reset(speed_filter_state * f) {                                  //start filters over on the next reading
+  f->valid = false;
+  f->median_fill = 0;
+  f->median_pos = 0;
+}
+static int32_t median_filter(speed_filter_state * f, int32_t z) {                  //median of the last median_size readings
+  int32_t sorted[median_size];
+  f->median_buf[f->median_pos] = z;
+  f->median_pos = (f->median_pos + 1) % median_size;
+  if (f->median_fill < median_size) {
+    f->median_fill = f->median_fill + 1;
+    }
+  for (uint8_t i = 0; i < f->median_fill; i++) {                                    //insertion sort, at most 5 values
+    int32_t val = f->median_buf[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > val) {
+      sorted[j] = sorted[j - 1];
+      j = j - 1;
+      }
+    sorted[j] = val;
+    }
+  return sorted[f->median_fill / 2];
+}
+void kalman_step(speed_filter_state * f, int32_t z, int32_t dt_us, const kalman_gain * g) {   //64 bit terms, saturated back to int32
+  int32_t adt = sat_q16((int64_t)f->a * dt_us / 1000000);                          //acceleration x time
+  int32_t xp = sat_q16((int64_t)f->x + (int64_t)f->v * dt_us / 1000000 + (int64_t)adt * dt_us / 2000000);
+  int32_t vp = sat_q16((int64_t)f->v + adt);
+  int64_t r = (int64_t)z - xp;
+  f->x = sat_q16(xp + (((int64_t)g->k1 * r) >> 16));
+  f->v = sat_q16(vp + (((int64_t)g->k2 * r) >> 16));
+  f->a = sat_q16(f->a + (((int64_t)g->k3 * r) >> 16));
+}
+int32_t speed_filter(speed_filter_state * f, uint8_t type, int32_t z, int32_t dt_us) {   //speed filter (option screen "Avg/Speed" checkbox)
+  if (type == filter_none) {
+    return z;
+    }
+  if (f->valid == false || dt_us > filter_restart_us || dt_us <= 0) {              //first reading or stopped for a while, start from this reading
+    f->x = z;
+    f->v = 0;
+    f->a = 0;
+    f->valid = true;
+    f->median_fill = 0;
+    }
+  if (dt_us < kalman_bucket_us) {                                                   //readings closer than 1ms count as 1ms apart, keeps rate terms in range
+    dt_us = kalman_bucket_us;
+    }
+  if (type == filter_median_kalman) {
+    z = median_filter(f, z);
+    }
+  switch (type) {
+    case filter_iir:
+      if (z <= f->x + f->x / 2 && z >= f->x / 2) {                                   //is value within 50% of last value?
+        f->x = (z + 3 * (int64_t)f->x) / 4;                                         //4 reading average with 3x weight given to last reading
+        }
+      else {
+        f->x = z;
+        }
+      break;
+    case filter_alpha_beta: {
+      int32_t xp = sat_q16((int64_t)f->x + (int64_t)f->v * dt_us / 1000000);       //predict speed from rate
+      int64_t r = (int64_t)z - xp;                                                  //error between reading and prediction
+      f->x = sat_q16(xp + ((ab_alpha * r) >> 16));
+      f->v = sat_q16(f->v + ((ab_beta * r) >> 16) * 1000000 / dt_us);              //beta x error before scaling to per second, stays in 64 bits
+      break;
+      }
+    case filter_kalman:
+    case filter_median_kalman: {
+      const kalman_gain * g = kalman_gain_for(dt_us);
+      if (g->k1 == 65536 && g->k2 == 0 && g->k3 == 0) {                             //pass through bucket, rate terms start over from the reading
+        f->x = z;
+        f->v = 0;
+        f->a = 0;
+        }
+      else {
+        kalman_step(f, z, dt_us, g);
+        }
+      break;
+      }
+    }
+  if (f->x < 0) {                                                                   //speed can not be negative
+    f->x = 0;
+    }
+  return f->x;
+}
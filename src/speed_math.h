@@ -0,0 +1,95 @@
+/**********************
+    Fixed point speed math, mph x 65536 (Q16) from pulse count to screen text, the adaptive gate and the speed filters.
+    No Arduino or esp32 calls so the native env and the unit tests build it as is.
+ **********************/
+#ifndef SPEED_MATH_H
+#define SPEED_MATH_H
+
+#include <stdint.h>
+
+#define kph_q30 1727865343LL         //1.6092 x 2^30, mph to kph
+#define fpm_q16 5767168              //88 x 65536, mph to feet per minute
+#define mpm_q16 1757873              //26.8224 x 65536, mph to meters per minute
+#define gate_us 250000               //fixed gate time (250ms)
+#define gate_tick_us 10000           //timer tick used by the adaptive gate (10ms)
+#define adapt_target 100             //adaptive gate closes once this many pulses are counted (1% resolution)
+#define adapt_min_ticks 5            //shortest adaptive gate in ticks (50ms)
+#define adapt_max_ticks 100          //longest adaptive gate in ticks (1 second), 0 speed if no pulse in this time
+
+#define filter_none 0                //speed_avg values (option screen "Avg/Speed" checkbox steps through them)
+#define filter_iir 1                 //4 reading average, 3x weight on last reading, only if within 50% of last reading
+#define filter_alpha_beta 2          //position / rate tracker
+#define filter_kalman 3              //constant acceleration kalman filter, steady state gains
+#define filter_median_kalman 4       //median of the last 5 readings then kalman
+#define filter_count 5
+#define ab_alpha 26214               //alpha-beta gains (Q16, 0.4)
+#define ab_beta 6554                 //(Q16, 0.1)
+#define kalman_q 5.0f                //kalman process noise, jerk (mph/s^3)^2 per second
+#define kalman_r 0.09f               //kalman measurement noise (mph^2), about 0.3 mph
+#define kalman_buckets 11            //steady state gains for readings 1, 2, 4 ... 1024ms apart
+#define kalman_bucket_us 1000        //time between readings of the first bucket, also the shortest time the filters use
+#define kalman_iterations 5000       //most riccati steps per bucket, 1ms needs about 1100 to settle
+#define kalman_pass_ratio 0.9f       //a bucket whose gains keep more than this much of the reading noise (rms) passes readings through
+#define filter_restart_us 2000000    //no reading for this long, the filters start over from the next reading
+#define median_size 5                //median prefilter length
+
+struct adapt_gate_state {                          //adaptive gate, kept by the timer interrupt
+  uint32_t ticks;                                  //ticks since the gate started
+  uint32_t idle;                                   //ticks waiting for the first pulse of a gate
+};
+
+struct kalman_gain {                               //steady state kalman gains (Q16: speed, 1/s, 1/s^2)
+  int32_t k1;
+  int32_t k2;
+  int32_t k3;
+};
+
+struct speed_filter_state {                        //filter state, kept by the speed task
+  int32_t x;                                       //filtered speed (Q16 mph)
+  int32_t v;                                       //rate of change (Q16 mph/s)
+  int32_t a;                                       //acceleration (Q16 mph/s^2, kalman only)
+  bool valid;                                      //false until the first reading after a reset
+  int32_t median_buf[median_size];
+  uint8_t median_pos;
+  uint8_t median_fill;
+};
+
+uint64_t speed_q_for_cal(int cal);                 //Q16 mph = pulses * speed_q_for_cal(cal) / time in us
+uint32_t round_q16(uint64_t n);                    //Q16 to whole number, ties to even (same as printf)
+void format_speed(char * buf, int32_t q);          //"%4.1f" (50 and under) or "%4.0f" (over 50) without printf
+void format_uint(char * buf, uint32_t n);          //unsigned number to text without printf
+int32_t gate_speed_q16(uint32_t pulses, uint64_t q_const, uint32_t time_us);   //Q16 mph from the pulses counted in a gate
+
+void kalman_solve(float dt, kalman_gain * g);     //steady state gains for readings dt seconds apart (float, slow)
+float kalman_noise_ratio(float dt, const kalman_gain * g);   //rms of the output / rms of the reading noise at a steady speed
+void speed_filter_init(void);                      //work out the gains of every bucket (run once at start up)
+const kalman_gain * kalman_gain_for(int32_t dt_us);   //gains of the bucket nearest to dt_us
+void speed_filter_reset(speed_filter_state * f);   //start over on the next reading
+void kalman_step(speed_filter_state * f, int32_t z, int32_t dt_us, const kalman_gain * g);   //predict dt_us ahead, update with reading z
+int32_t speed_filter(speed_filter_state * f, uint8_t type, int32_t z, int32_t dt_us);   //filtered Q16 mph of reading z, dt_us after the last one
+
+/* One gate_tick_us tick of the adaptive gate, count = pulses since the gate started.
+   Returns the gate length in us if the gate closes on this tick, 0 while it stays open.
+   Inline so the timer interrupt runs it from IRAM. */
+static inline __attribute__((always_inline)) uint32_t adapt_gate_tick(adapt_gate_state * g, uint32_t count) {
+  uint32_t length;
+  if (count == 0) {                                //gate starts on the first pulse
+    g->idle = g->idle + 1;
+    if (g->idle < adapt_max_ticks) {
+      return 0;
+      }
+    length = adapt_max_ticks * gate_tick_us;       //no pulse for the longest gate, report 0 speed
+    }
+  else {
+    g->ticks = g->ticks + 1;
+    if (g->ticks < adapt_max_ticks && (count < adapt_target || g->ticks < adapt_min_ticks)) {
+      return 0;                                    //keep gate open until enough pulses are counted
+      }
+    length = g->ticks * gate_tick_us;
+    }
+  g->ticks = 0;
+  g->idle = 0;
+  return length;
+}
+
+#endif
@@ -0,0 +1,74 @@
+/**
+ * @file test_corner_cache.c
+ * Benchmark of the corner masks of rounded rectangles (LV_DRAW_CORNER_CACHE_SIZE): redrawing a dialog
+ * like the option and factory screens with the cached masks and with ref_draw_rect() of
+ * lv_draw_rect_ref.c. Only prints the times, draw/test_corner_cache checks the pixels.
+ *
+ * pio test -e native_bench -f draw/bench/test_corner_cache
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "draw_fixture.h"
+#include "lv_draw_rect_ref.h"
+
+#define BENCH_LOOPS 20       /*full redraws per run*/
+#define BENCH_RUNS 10        /*the fastest run counts*/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*Full redraws of the active screen, best of BENCH_RUNS*/
+static double redraw_timed(draw_rect_t draw)
+{
+    draw_rect   = draw;
+    double best = 1e12;
+    redraw(); /*the masks are made in the first redraws*/
+    redraw();
+    uint32_t r, n;
+    for(r = 0; r < BENCH_RUNS; r++) {
+        double t = now_us();
+        for(n = 0; n < BENCH_LOOPS; n++) redraw();
+        t = now_us() - t;
+        if(t < best) best = t;
+    }
+    return best / BENCH_LOOPS;
+}
+
+void test_benchmark(void)
+{
+    lv_obj_t * scr = dialog_screen();
+    lv_scr_load(scr);
+    uint8_t aa;
+    for(aa = 0; aa < 2; aa++) {
+        set_aa(aa);
+        double cached = redraw_timed(lv_draw_rect);
+        double ref    = redraw_timed(ref_draw_rect);
+        char msg[120];
+        snprintf(msg, sizeof(msg), "dialog aa %u: full redraw %.0f us, old corners %.0f us (%.2fx)", (unsigned)aa,
+                 cached, ref, ref / cached);
+        TEST_MESSAGE(msg);
+    }
+    lv_obj_del(scr);
+}
+
+int main(void)
+{
+    draw_fixture_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_draw_565x2.c
+ * Benchmark of the RGB565 fill and blend kernels of lv_draw_basic.c (two pixels per 32 bit word):
+ * full draw buffer fills and blends against the same work one pixel at a time with lv_color_mix.
+ * Only prints the times, draw/test_draw_565x2 checks the pixels.
+ *
+ * pio test -e native_bench -f draw/bench/test_draw_565x2
+ */
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unity.h>
+#include "draw_fixture.h"
+
+#define BENCH_LOOPS 500      /*full buffer fills/blends per benchmark*/
+
+static lv_color_t ref[VDB_W * VDB_H];
+static lv_color_t map[VDB_W * VDB_H];
+static uint32_t seed = 1;
+
+static uint32_t rnd(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    c.full = (uint16_t)rnd();
+    return c;
+}
+
+/*Random screen in the draw buffer and the same in the reference*/
+static void fill_random(void)
+{
+    uint32_t i;
+    for(i = 0; i < VDB_W * VDB_H; i++) vdb[i] = rnd_color();
+    memcpy(ref, vdb, sizeof(vdb));
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void report(const char * what, double us_kernel, double us_scalar)
+{
+    char msg[128];
+    double px = (double)VDB_W * VDB_H * BENCH_LOOPS;
+    snprintf(msg, sizeof(msg), "%-12s %7.1f Mpx/s, one pixel at a time %7.1f Mpx/s (%.2fx)", what, px / us_kernel,
+             px / us_scalar, us_scalar / us_kernel);
+    TEST_MESSAGE(msg);
+}
+
+/*Full draw buffer fills and blends against the same work one pixel at a time with lv_color_mix*/
+void test_benchmark(void)
+{
+    lv_area_t a = {0, 0, VDB_W - 1, VDB_H - 1};
+    lv_color_t color = LV_COLOR_MAKE(0x20, 0x80, 0xC0);
+    uint32_t n, i;
+    for(i = 0; i < VDB_W * VDB_H; i++) map[i] = rnd_color();
+
+    fill_random();
+    double t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) lv_draw_fill(&a, &a, color, LV_OPA_COVER);
+    double kernel = now_us() - t;
+    t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) {
+        for(i = 0; i < VDB_W * VDB_H; i++) ref[i] = color;
+        __asm__ __volatile__("" : : "r"(ref) : "memory"); /*keep the loop*/
+    }
+    report("fill", kernel, now_us() - t);
+
+    fill_random();
+    t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) lv_draw_fill(&a, &a, color, LV_OPA_50);
+    kernel = now_us() - t;
+    t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) {
+        for(i = 0; i < VDB_W * VDB_H; i++) ref[i] = lv_color_mix(color, ref[i], LV_OPA_50);
+        __asm__ __volatile__("" : : "r"(ref) : "memory");
+    }
+    report("fill 50%", kernel, now_us() - t);
+
+    fill_random();
+    t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) {
+        lv_draw_map(&a, &a, (const uint8_t *)map, LV_OPA_50, false, false, LV_COLOR_BLACK, LV_OPA_TRANSP);
+    }
+    kernel = now_us() - t;
+    t = now_us();
+    for(n = 0; n < BENCH_LOOPS; n++) {
+        for(i = 0; i < VDB_W * VDB_H; i++) ref[i] = lv_color_mix(map[i], ref[i], LV_OPA_50);
+        __asm__ __volatile__("" : : "r"(ref) : "memory");
+    }
+    report("blend 50%", kernel, now_us() - t);
+}
+
+int main(void)
+{
+    draw_vdb_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_shadow_cache.c
+ * Benchmark of the shadow profile cache (LV_DRAW_SHADOW_CACHE_SIZE): a message box with a shadow moving
+ * over buttons and knobs with shadows, drawn from the cached profiles and with ref_shadow_draw_rect() of
+ * lv_draw_shadow_ref.c. Only prints the times, draw/test_shadow_cache checks the frames.
+ *
+ * pio test -e native_bench -f draw/bench/test_shadow_cache
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "draw_fixture.h"
+#include "lv_draw_rect_ref.h"
+
+#define BENCH_FRAMES 200     /*frames per benchmark run*/
+#define BENCH_RUNS 10        /*the fastest run counts*/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*The message box moving over the others, only the changed areas are redrawn. Best of BENCH_RUNS*/
+static double anim_timed(draw_rect_t draw)
+{
+    draw_rect   = draw;
+    double best = 1e12;
+    redraw();
+    uint32_t r, k;
+    for(r = 0; r < BENCH_RUNS; r++) {
+        double t = now_us();
+        for(k = 0; k < BENCH_FRAMES; k++) {
+            shadow_mbox_move(k);
+            lv_refr_now(NULL);
+        }
+        t = now_us() - t;
+        if(t < best) best = t;
+    }
+    return best / BENCH_FRAMES;
+}
+
+void test_benchmark(void)
+{
+    lv_obj_t * scr = shadow_screen(false);
+    lv_scr_load(scr);
+    uint8_t aa;
+    for(aa = 0; aa < 2; aa++) {
+        set_aa(aa);
+        double cached = anim_timed(lv_draw_rect);
+        double ref    = anim_timed(ref_shadow_draw_rect);
+        char msg[120];
+        snprintf(msg, sizeof(msg), "message box animation aa %u: %.0f us per frame, calculated shadows %.0f us (%.2fx)",
+                 (unsigned)aa, cached, ref, ref / cached);
+        TEST_MESSAGE(msg);
+    }
+    lv_obj_del(scr);
+}
+
+int main(void)
+{
+    draw_fixture_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
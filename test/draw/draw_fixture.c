@@ -0,0 +1,169 @@
+/**
+ * @file draw_fixture.c
+ * The display and screens shared by the tests and benchmarks of test/draw, see draw_fixture.h
+ */
+#include <string.h>
+#include "draw_fixture.h"
+
+lv_color_t fb[HOR_RES * VER_RES];
+draw_rect_t draw_rect = lv_draw_rect;
+lv_color_t vdb[VDB_W * VDB_H];
+
+static lv_disp_buf_t disp_buf;
+static lv_color_t buf[HOR_RES * 10]; /*10 rows like the firmware*/
+
+static lv_style_t mbox_style;   /*full shadow, the message box*/
+static lv_style_t panel_style;  /*full shadow, other color*/
+static lv_style_t btn_style;    /*bottom shadow*/
+static lv_style_t knob_style;   /*full shadow, round*/
+static lv_style_t pulse_style;  /*its shadow width changes every frame*/
+static lv_style_t big_style;    /*a profile too large for the cache*/
+static lv_obj_t * mbox;
+static lv_obj_t * pulse;
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        memcpy(&fb[y * HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+static void no_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+/*A rectangle drawn with `draw_rect`*/
+static bool rect_design(lv_obj_t * obj, const lv_area_t * mask, lv_design_mode_t mode)
+{
+    if(mode == LV_DESIGN_COVER_CHK) return false;
+    if(mode == LV_DESIGN_DRAW_MAIN) draw_rect(&obj->coords, mask, lv_obj_get_style(obj), lv_obj_get_opa_scale(obj));
+    return true;
+}
+
+void draw_fixture_init(void)
+{
+    lv_init();
+    lv_disp_buf_init(&disp_buf, buf, NULL, HOR_RES * 10);
+    lv_disp_drv_t drv;
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = HOR_RES;
+    drv.ver_res  = VER_RES;
+    drv.flush_cb = flush_cb;
+    drv.buffer   = &disp_buf;
+    lv_disp_drv_register(&drv);
+}
+
+void draw_vdb_init(void)
+{
+    lv_init();
+    lv_disp_buf_init(&disp_buf, vdb, NULL, VDB_W * VDB_H);
+    lv_disp_drv_t drv;
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = VDB_W;
+    drv.ver_res  = VDB_H;
+    drv.flush_cb = no_flush_cb;
+    drv.buffer   = &disp_buf;
+    lv_disp_t * disp = lv_disp_drv_register(&drv);
+
+    lv_disp_buf_t * db = lv_disp_get_buf(disp);
+    db->area.x1        = 0;
+    db->area.y1        = 0;
+    db->area.x2        = VDB_W - 1;
+    db->area.y2        = VDB_H - 1;
+    db->buf_act        = vdb;
+    lv_refr_set_disp_refreshing(disp);
+}
+
+lv_obj_t * rect_create(lv_obj_t * scr, const lv_style_t * style, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                       lv_coord_t h)
+{
+    lv_obj_t * obj = lv_obj_create(scr, NULL);
+    lv_obj_set_style(obj, style);
+    lv_obj_set_design_cb(obj, rect_design);
+    lv_obj_set_pos(obj, x, y);
+    lv_obj_set_size(obj, w, h);
+    return obj;
+}
+
+lv_obj_t * dialog_screen(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    rect_create(scr, &lv_style_pretty, 20, 20, 440, 280);
+    uint32_t i;
+    for(i = 0; i < 12; i++) {
+        lv_coord_t x = 40 + (i % 3) * 140;
+        lv_coord_t y = 40 + (i / 3) * 60;
+        rect_create(scr, i % 4 == 3 ? &lv_style_btn_pr : &lv_style_btn_rel, x, y, 120, 44);
+        rect_create(scr, &lv_style_pretty_color, x + 4, y + 50, 20, 20);
+    }
+    return scr;
+}
+
+static void shadow_styles_init(void)
+{
+    lv_style_copy(&mbox_style, &lv_style_pretty);
+    mbox_style.body.radius       = 8;
+    mbox_style.body.shadow.width = 12;
+    mbox_style.body.shadow.type  = LV_SHADOW_FULL;
+    mbox_style.body.shadow.color = LV_COLOR_BLACK;
+    lv_style_copy(&panel_style, &mbox_style);
+    panel_style.body.radius       = 4;
+    panel_style.body.shadow.width = 6;
+    panel_style.body.shadow.color = LV_COLOR_MAKE(0x40, 0x00, 0x00);
+    lv_style_copy(&btn_style, &lv_style_btn_rel);
+    btn_style.body.shadow.width = 4;
+    btn_style.body.shadow.type  = LV_SHADOW_BOTTOM;
+    lv_style_copy(&knob_style, &lv_style_pretty_color);
+    knob_style.body.radius       = LV_RADIUS_CIRCLE;
+    knob_style.body.shadow.width = 5;
+    knob_style.body.shadow.type  = LV_SHADOW_FULL;
+    lv_style_copy(&pulse_style, &knob_style);
+    lv_style_copy(&big_style, &knob_style);
+    big_style.body.shadow.width = 20;
+    big_style.body.opa          = 160;
+}
+
+lv_obj_t * shadow_screen(bool big)
+{
+    shadow_styles_init();
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    rect_create(scr, &panel_style, 20, 250, 200, 50);
+    rect_create(scr, &panel_style, 260, 250, 200, 50);
+    uint32_t i;
+    for(i = 0; i < 4; i++) rect_create(scr, &btn_style, 80 + i * 80, 180, 60, 40);
+    for(i = 0; i < 3; i++) rect_create(scr, &knob_style, 400, 20 + i * 50, 30, 30);
+    pulse = rect_create(scr, &pulse_style, 20, 20, 40, 40);
+    if(big) rect_create(scr, &big_style, 250, 60, 150, 150);
+    mbox = rect_create(scr, &mbox_style, 60, 40, 350, 200);
+    return scr;
+}
+
+void shadow_anim_frame(uint32_t k)
+{
+    shadow_mbox_move(k);
+    pulse_style.body.shadow.width = 1 + k % 16;
+    lv_obj_refresh_style(pulse);
+}
+
+void shadow_mbox_move(uint32_t k)
+{
+    lv_obj_set_pos(mbox, 60 + k % 7, 10 + (k % 20) * 3);
+}
+
+void set_aa(bool aa)
+{
+    lv_disp_get_default()->driver.antialiasing = aa ? 1 : 0;
+}
+
+void redraw(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
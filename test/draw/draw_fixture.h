@@ -0,0 +1,79 @@
+/**
+ * @file draw_fixture.h
+ * A 480x320 display for the tests and benchmarks of test/draw. lvgl draws 10 rows at a time like the
+ * firmware and the flushes land in `fb`. The objects of rect_create() draw with `draw_rect`, so the
+ * same screen can be drawn with lv_draw_rect() and with a reference build of it.
+ * Or a display whose draw buffer `vdb` is drawn into directly, for the fill and blend kernels.
+ */
+#ifndef DRAW_FIXTURE_H
+#define DRAW_FIXTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl/lvgl.h"
+
+#define HOR_RES 480
+#define VER_RES 320
+#define VDB_W 480
+#define VDB_H 20
+
+typedef void (*draw_rect_t)(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                            lv_opa_t opa_scale);
+
+extern lv_color_t fb[HOR_RES * VER_RES];
+extern draw_rect_t draw_rect; /*lv_draw_rect by default*/
+extern lv_color_t vdb[VDB_W * VDB_H];
+
+/**
+ * lv_init() and register the display
+ */
+void draw_fixture_init(void);
+
+/**
+ * lv_init() and register a display with `vdb` as draw buffer. It's set up like lv_refr does while it
+ * draws a strip, so lv_draw_fill() and lv_draw_map() draw straight into `vdb`.
+ */
+void draw_vdb_init(void);
+
+/**
+ * Create an object on `scr` which draws its main part with `draw_rect`
+ */
+lv_obj_t * rect_create(lv_obj_t * scr, const lv_style_t * style, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                       lv_coord_t h);
+
+/**
+ * A message box with rows of buttons and check boxes, like the option and factory screens
+ */
+lv_obj_t * dialog_screen(void);
+
+/**
+ * Buttons, knobs and panels with shadows under a message box with a shadow
+ * @param big true: also an object with a shadow profile too large for the shadow cache
+ */
+lv_obj_t * shadow_screen(bool big);
+
+/**
+ * Frame `k` of the shadow screen's animation: the message box slides and shakes,
+ * a pulsing shadow grows (more profiles than the cache holds)
+ */
+void shadow_anim_frame(uint32_t k);
+
+/**
+ * Move only the message box of the shadow screen as in frame `k`
+ */
+void shadow_mbox_move(uint32_t k);
+
+void set_aa(bool aa);
+
+/**
+ * Redraw the whole active screen now
+ */
+void redraw(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*DRAW_FIXTURE_H*/
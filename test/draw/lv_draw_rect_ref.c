@@ -0,0 +1,17 @@
+/**
+ * @file lv_draw_rect_ref.c
+ * lv_draw_rect.c again with the corner and shadow caches off and the functions renamed to ref_*,
+ * see lv_draw_rect_ref.h
+ */
+#include "lv_conf.h"
+
+#undef LV_DRAW_CORNER_CACHE_SIZE
+#define LV_DRAW_CORNER_CACHE_SIZE 0
+#undef LV_DRAW_SHADOW_CACHE_SIZE
+#define LV_DRAW_SHADOW_CACHE_SIZE 0
+#define lv_draw_rect ref_draw_rect
+#define lv_draw_shadow_cache_get_stat ref_shadow_cache_get_stat
+#include "lvgl/src/lv_draw/lv_draw_rect.c"
+#include "lv_draw_rect_ref.h"
+
+const uint32_t corner_cache_max_radius = CORNER_CACHE_MAX_RADIUS;
@@ -0,0 +1,31 @@
+/**
+ * @file lv_draw_rect_ref.h
+ * lv_draw_rect() without the corner and shadow caches (LV_DRAW_CORNER_CACHE_SIZE and
+ * LV_DRAW_SHADOW_CACHE_SIZE 0), and without only the shadow cache, for the tests and benchmarks of
+ * test/draw to compare the caches with.
+ */
+#ifndef LV_DRAW_RECT_REF_H
+#define LV_DRAW_RECT_REF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl/lvgl.h"
+
+void ref_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
+void ref_shadow_cache_get_stat(uint32_t * hit, uint32_t * miss);
+
+/*lv_draw_shadow_ref.c: shadows are calculated on every draw, the corners come from its own corner cache*/
+void ref_shadow_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
+                          lv_opa_t opa_scale);
+void ref_shadow_get_stat(uint32_t * hit, uint32_t * miss);
+
+/*Largest radius with a cached corner mask (CORNER_CACHE_MAX_RADIUS of lv_draw_rect.c)*/
+extern const uint32_t corner_cache_max_radius;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_RECT_REF_H*/
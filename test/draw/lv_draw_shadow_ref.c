@@ -0,0 +1,13 @@
+/**
+ * @file lv_draw_shadow_ref.c
+ * lv_draw_rect.c again with only the shadow cache off and the functions renamed to ref_shadow_*,
+ * see lv_draw_rect_ref.h
+ */
+#include "lv_conf.h"
+
+#undef LV_DRAW_SHADOW_CACHE_SIZE
+#define LV_DRAW_SHADOW_CACHE_SIZE 0
+#define lv_draw_rect ref_shadow_draw_rect
+#define lv_draw_shadow_cache_get_stat ref_shadow_get_stat
+#include "lvgl/src/lv_draw/lv_draw_rect.c"
+#include "lv_draw_rect_ref.h"
@@ -0,0 +1,151 @@
+/**
+ * @file test_corner_cache.c
+ * Corner masks of rounded rectangles (LV_DRAW_CORNER_CACHE_SIZE): screens of rounded objects drawn from
+ * the cached masks against calculating every corner with ref_draw_rect() of lv_draw_rect_ref.c, and
+ * the heap the masks use. The timing is in bench/test_corner_cache.
+ *
+ * pio test -e native -f draw/test_corner_cache
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include "draw_fixture.h"
+#include "lv_draw_rect_ref.h"
+
+#define RANDOM_CNT 40        /*objects of the random screen*/
+#define MAX_DIFF 2           /*anti-aliased pixels are blended once with the mask instead of twice*/
+#define HEAP_SLACK 128       /*headers of the mask blocks in the heap*/
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static lv_style_t styles[RANDOM_CNT];
+static uint32_t seed = 1;
+
+static uint32_t rnd(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/*Any radius, border, gradient and opacity. Some are too small for their radius or overlap*/
+static lv_obj_t * random_screen(void)
+{
+    lv_obj_t * scr = lv_obj_create(NULL, NULL);
+    uint32_t i;
+    for(i = 0; i < RANDOM_CNT; i++) {
+        lv_style_t * s = &styles[i];
+        lv_style_copy(s, &lv_style_plain);
+        s->body.radius            = i % 10 == 9 ? LV_RADIUS_CIRCLE : rnd() % 37;
+        s->body.main_color.full   = (uint16_t)rnd();
+        s->body.grad_color        = i % 3 == 0 ? s->body.main_color : (lv_color_t){.full = (uint16_t)rnd()};
+        s->body.opa               = i % 4 == 0 ? 100 + rnd() % 155 : LV_OPA_COVER;
+        s->body.border.width      = rnd() % 4;
+        s->body.border.color.full = (uint16_t)rnd();
+        s->body.border.opa        = i % 5 == 0 ? LV_OPA_50 : LV_OPA_COVER;
+        rect_create(scr, s, (i % 8) * 60, (i / 8) * 64, 4 + rnd() % 70, 4 + rnd() % 70);
+    }
+    return scr;
+}
+
+/*The screen with the old corners to `ref_fb`, then with the masks (remembered, created, from the cache)*/
+static void check_screen(lv_obj_t * scr, const char * name)
+{
+    lv_scr_load(scr);
+    uint8_t aa;
+    for(aa = 0; aa < 2; aa++) {
+        set_aa(aa);
+        draw_rect = ref_draw_rect;
+        redraw();
+        memcpy(ref_fb, fb, sizeof(fb));
+
+        draw_rect = lv_draw_rect;
+        uint32_t pass, diff_cnt = 0;
+        for(pass = 0; pass < 3; pass++) {
+            redraw();
+            uint32_t i;
+            for(i = 0; i < HOR_RES * VER_RES; i++) {
+                if(fb[i].full == ref_fb[i].full) continue;
+                diff_cnt++;
+                char msg[80];
+                snprintf(msg, sizeof(msg), "%s aa %u pass %u x %u y %u", name, (unsigned)aa, (unsigned)pass,
+                         (unsigned)(i % HOR_RES), (unsigned)(i / HOR_RES));
+                TEST_ASSERT_INT_WITHIN_MESSAGE(MAX_DIFF, LV_COLOR_GET_R(ref_fb[i]), LV_COLOR_GET_R(fb[i]), msg);
+                TEST_ASSERT_INT_WITHIN_MESSAGE(MAX_DIFF, LV_COLOR_GET_G(ref_fb[i]), LV_COLOR_GET_G(fb[i]), msg);
+                TEST_ASSERT_INT_WITHIN_MESSAGE(MAX_DIFF, LV_COLOR_GET_B(ref_fb[i]), LV_COLOR_GET_B(fb[i]), msg);
+            }
+        }
+        char msg[80];
+        snprintf(msg, sizeof(msg), "%s aa %u: %u pixels off by 1-%u LSB in 3 redraws", name, (unsigned)aa,
+                 (unsigned)diff_cnt, MAX_DIFF);
+        TEST_MESSAGE(msg);
+    }
+    lv_obj_del(scr);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_dialog(void)
+{
+    check_screen(dialog_screen(), "dialog");
+}
+
+void test_random(void)
+{
+    check_screen(random_screen(), "random");
+}
+
+/*Every radius with and without a border: the masks stay in LV_DRAW_CORNER_CACHE_MEM and nothing else is allocated*/
+void test_heap(void)
+{
+    lv_style_t * radius_styles = malloc(2 * corner_cache_max_radius * sizeof(lv_style_t));
+    lv_obj_t * scr             = lv_obj_create(NULL, NULL);
+    uint32_t i;
+    for(i = 0; i < 2 * corner_cache_max_radius; i++) {
+        lv_style_copy(&radius_styles[i], &lv_style_btn_rel);
+        radius_styles[i].body.radius       = i / 2 + 1;
+        radius_styles[i].body.border.width = i % 2 ? 0 : 2;
+        rect_create(scr, &radius_styles[i], (i % 8) * 58, (i / 8) * 36, 70, 70);
+    }
+    lv_scr_load(scr);
+    set_aa(true);
+    draw_rect = lv_draw_rect;
+
+    lv_mem_monitor_t before;
+    lv_mem_monitor(&before);
+    uint32_t used_before = before.total_size - before.free_size;
+    uint32_t pass;
+    for(pass = 0; pass < 3; pass++) redraw();
+    lv_mem_monitor_t after;
+    lv_mem_monitor(&after);
+    uint32_t used_after = after.total_size - after.free_size;
+
+    uint32_t limit = used_before + LV_DRAW_CORNER_CACHE_MEM + HEAP_SLACK;
+    char msg[120];
+    snprintf(msg, sizeof(msg), "masks: %u bytes, peak %u bytes over the objects", (unsigned)(used_after - used_before),
+             (unsigned)(after.max_used > used_before ? after.max_used - used_before : 0));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(limit, used_after);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_MATH_MAX(before.max_used, limit), after.max_used);
+
+    lv_obj_del(scr);
+    free(radius_styles);
+}
+
+int main(void)
+{
+    draw_fixture_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_dialog);
+    RUN_TEST(test_random);
+    RUN_TEST(test_heap);
+    return UNITY_END();
+}
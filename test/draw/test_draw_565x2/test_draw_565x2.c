@@ -0,0 +1,169 @@
+/**
+ * @file test_draw_565x2.c
+ * RGB565 fill and blend kernels of lv_draw_basic.c (two pixels per 32 bit word)
+ * against lv_color_mix one pixel at a time. The timing is in bench/test_draw_565x2.
+ *
+ * pio test -e native -f draw/test_draw_565x2
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "draw_fixture.h"
+
+#define RUNS 2000            /*random cases per test*/
+
+static lv_color_t ref[VDB_W * VDB_H];
+static lv_color_t map[VDB_W * VDB_H + 1]; /*one more so the map can start on an odd pixel*/
+static uint32_t seed = 1;
+
+static uint32_t rnd(void)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    c.full = (uint16_t)rnd();
+    return c;
+}
+
+/*Random screen in the draw buffer and the same in the reference*/
+static void fill_random(void)
+{
+    uint32_t i;
+    for(i = 0; i < VDB_W * VDB_H; i++) vdb[i] = rnd_color();
+    memcpy(ref, vdb, sizeof(vdb));
+}
+
+/*Random area of the draw buffer, 1 px to full width so both row alignments and odd lengths come up*/
+static lv_area_t rnd_area(void)
+{
+    lv_area_t a;
+    a.x1 = rnd() % VDB_W;
+    a.x2 = a.x1 + rnd() % (VDB_W - a.x1);
+    a.y1 = rnd() % VDB_H;
+    a.y2 = a.y1 + rnd() % (VDB_H - a.y1);
+    return a;
+}
+
+/*Opacity as lv_draw_fill/lv_draw_map use it*/
+static lv_opa_t draw_opa(lv_opa_t opa)
+{
+    return opa > LV_OPA_MAX ? LV_OPA_COVER : opa;
+}
+
+static void check_vdb(const char * what, lv_opa_t opa)
+{
+    uint32_t i;
+    for(i = 0; i < VDB_W * VDB_H; i++) {
+        if(vdb[i].full != ref[i].full) {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "%s opa %u x %u y %u", what, (unsigned)opa, (unsigned)(i % VDB_W),
+                     (unsigned)(i / VDB_W));
+            TEST_ASSERT_EQUAL_HEX16_MESSAGE(ref[i].full, vdb[i].full, msg);
+        }
+    }
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Every opacity on random pixel pairs, a 2 px fill is one mix_565x2*/
+void test_mix_every_opa(void)
+{
+    lv_area_t mask = {0, 0, VDB_W - 1, VDB_H - 1};
+    uint32_t opa;
+    for(opa = 0; opa <= 255; opa++) {
+        uint32_t n;
+        for(n = 0; n < 64; n++) {
+            fill_random();
+            lv_color_t color = rnd_color();
+            lv_area_t a;
+            a.x1 = (rnd() % (VDB_W / 2)) * 2;
+            a.x2 = a.x1 + 1;
+            a.y1 = rnd() % VDB_H;
+            a.y2 = a.y1;
+            lv_draw_fill(&a, &mask, color, opa);
+            if(opa >= LV_OPA_MIN) {
+                lv_opa_t o = draw_opa(opa);
+                lv_coord_t x;
+                for(x = a.x1; x <= a.x2; x++) {
+                    ref[a.y1 * VDB_W + x] = o == LV_OPA_COVER ? color : lv_color_mix(color, ref[a.y1 * VDB_W + x], o);
+                }
+            }
+            check_vdb("mix", opa);
+        }
+    }
+}
+
+/*sw_fill_row and the two pixel opacity fill on random areas*/
+void test_fill(void)
+{
+    lv_area_t mask = {0, 0, VDB_W - 1, VDB_H - 1};
+    uint32_t n;
+    for(n = 0; n < RUNS; n++) {
+        fill_random();
+        lv_area_t a     = rnd_area();
+        lv_color_t color = rnd_color();
+        lv_opa_t opa    = (n & 1) ? LV_OPA_COVER : LV_OPA_MIN + rnd() % (256 - LV_OPA_MIN);
+        lv_draw_fill(&a, &mask, color, opa);
+
+        lv_opa_t o = draw_opa(opa);
+        lv_coord_t x, y;
+        for(y = a.y1; y <= a.y2; y++) {
+            for(x = a.x1; x <= a.x2; x++) {
+                lv_color_t * p = &ref[y * VDB_W + x];
+                *p             = o == LV_OPA_COVER ? color : lv_color_mix(color, *p, o);
+            }
+        }
+        check_vdb("fill", opa);
+    }
+}
+
+/*sw_blend_row_565x2 through lv_draw_map, the map starts on even and odd pixels*/
+void test_blend(void)
+{
+    lv_area_t mask = {0, 0, VDB_W - 1, VDB_H - 1};
+    uint32_t n;
+    for(n = 0; n < RUNS; n++) {
+        fill_random();
+        uint32_t i;
+        for(i = 0; i < sizeof(map) / sizeof(map[0]); i++) map[i] = rnd_color();
+        lv_area_t a            = rnd_area();
+        const lv_color_t * src = &map[rnd() & 1];
+        lv_opa_t opa           = (n % 4 == 0) ? LV_OPA_COVER : LV_OPA_MIN + rnd() % (256 - LV_OPA_MIN);
+        lv_draw_map(&a, &mask, (const uint8_t *)src, opa, false, false, LV_COLOR_BLACK, LV_OPA_TRANSP);
+
+        lv_opa_t o   = draw_opa(opa);
+        lv_coord_t w = lv_area_get_width(&a);
+        lv_coord_t x, y;
+        for(y = a.y1; y <= a.y2; y++) {
+            for(x = a.x1; x <= a.x2; x++) {
+                lv_color_t s   = src[(y - a.y1) * w + (x - a.x1)];
+                lv_color_t * p = &ref[y * VDB_W + x];
+                *p             = o == LV_OPA_COVER ? s : lv_color_mix(s, *p, o);
+            }
+        }
+        check_vdb("blend", opa);
+    }
+}
+
+int main(void)
+{
+    draw_vdb_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_mix_every_opa);
+    RUN_TEST(test_fill);
+    RUN_TEST(test_blend);
+    return UNITY_END();
+}
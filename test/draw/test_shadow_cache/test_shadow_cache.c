@@ -0,0 +1,108 @@
+/**
+ * @file test_shadow_cache.c
+ * Shadow profile cache (LV_DRAW_SHADOW_CACHE_SIZE): frames of a message box with a shadow moving over
+ * buttons and knobs with shadows, drawn from the cached profiles against calculating them every time
+ * with ref_shadow_draw_rect() of lv_draw_shadow_ref.c, the heap and the counters of the cache.
+ * The timing is in bench/test_shadow_cache.
+ *
+ * The reference build has its own corner cache, so the frames only differ where the shadows do.
+ *
+ * pio test -e native -f draw/test_shadow_cache
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "draw_fixture.h"
+#include "lv_draw_rect_ref.h"
+
+#define FRAMES 40            /*frames of the checked animation*/
+#define HEAP_SLACK 128       /*headers of the profile blocks in the heap*/
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Every frame the same with the cached profiles as with calculating them*/
+void test_frames(void)
+{
+    lv_obj_t * scr = shadow_screen(true);
+    lv_scr_load(scr);
+    uint32_t hit_start, miss_start;
+    lv_draw_shadow_cache_get_stat(&hit_start, &miss_start);
+
+    uint8_t aa;
+    for(aa = 0; aa < 2; aa++) {
+        set_aa(aa);
+        uint32_t k;
+        for(k = 0; k < FRAMES; k++) {
+            shadow_anim_frame(k);
+            draw_rect = ref_shadow_draw_rect;
+            redraw();
+            memcpy(ref_fb, fb, sizeof(fb));
+            draw_rect = lv_draw_rect;
+            redraw();
+
+            uint32_t i;
+            for(i = 0; i < HOR_RES * VER_RES; i++) {
+                if(fb[i].full != ref_fb[i].full) {
+                    char msg[80];
+                    snprintf(msg, sizeof(msg), "aa %u frame %u x %u y %u", (unsigned)aa, (unsigned)k,
+                             (unsigned)(i % HOR_RES), (unsigned)(i / HOR_RES));
+                    TEST_ASSERT_EQUAL_HEX16_MESSAGE(ref_fb[i].full, fb[i].full, msg);
+                }
+            }
+        }
+    }
+
+    uint32_t hit, miss;
+    lv_draw_shadow_cache_get_stat(&hit, &miss);
+    char msg[80];
+    snprintf(msg, sizeof(msg), "%u frames: %u hits, %u misses", 2 * FRAMES, (unsigned)(hit - hit_start),
+             (unsigned)(miss - miss_start));
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_GREATER_THAN_UINT32(miss - miss_start, hit - hit_start);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, miss - miss_start);
+    lv_obj_del(scr);
+}
+
+/*The profiles never take more than LV_DRAW_SHADOW_CACHE_SIZE from the heap, even while profiles are evicted*/
+void test_heap(void)
+{
+    lv_obj_t * scr = shadow_screen(true);
+    lv_scr_load(scr);
+    set_aa(true);
+    draw_rect = lv_draw_rect;
+
+    lv_mem_monitor_t before;
+    lv_mem_monitor(&before);
+    uint32_t used_before = before.total_size - before.free_size;
+    uint32_t limit       = used_before + LV_DRAW_SHADOW_CACHE_SIZE + HEAP_SLACK;
+    uint32_t k;
+    for(k = 0; k < FRAMES; k++) {
+        shadow_anim_frame(k);
+        redraw();
+        lv_mem_monitor_t mon;
+        lv_mem_monitor(&mon);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(limit, mon.total_size - mon.free_size);
+    }
+    lv_mem_monitor_t after;
+    lv_mem_monitor(&after);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_MATH_MAX(before.max_used, limit), after.max_used);
+    lv_obj_del(scr);
+}
+
+int main(void)
+{
+    draw_fixture_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_frames);
+    RUN_TEST(test_heap);
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+/**
+ * @file test_font_lookup.c
+ * Benchmark of the ASCII glyph id table and kerning cache of fmt_txt fonts (LV_FONT_FMT_TXT_CACHE):
+ * glyph descriptors and measuring the firmware's strings against the old cmap and kerning searches
+ * (lv_font_fmt_txt_ref.c). Only prints the times, font/test_font_lookup checks the results.
+ *
+ * pio test -e native_bench -f font/bench/test_font_lookup
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "lv_font_fmt_txt_ref.h"
+
+#define BENCH_LOOPS 200
+#define BENCH_RUNS 15        /*the fastest run counts, the others had interruptions*/
+
+typedef struct {
+    const char * name;
+    const lv_font_t * font;
+    lv_font_t ref;                   /*the same font with the old lookups*/
+    lv_font_fmt_txt_dsc_t ref_dsc;
+} font_pair_t;
+
+static font_pair_t fonts[] = {
+    {"Bebasneue", &Bebasneue},
+    {"roboto 16", &lv_font_roboto_16},
+    {"roboto 28", &lv_font_roboto_28},
+    {"roboto 28 compressed", &lv_font_roboto_28_compressed},
+};
+#define FONT_CNT (sizeof(fonts) / sizeof(fonts[0]))
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*Measure every string, like the labels do when their text is set. Best of BENCH_RUNS*/
+static double measure_strings(const lv_font_t * font)
+{
+    volatile lv_coord_t sink = 0;
+    double best              = 1e12;
+    uint32_t r, n, s;
+    for(r = 0; r < BENCH_RUNS; r++) {
+        double t = now_us();
+        for(n = 0; n < BENCH_LOOPS; n++) {
+            for(s = 0; s < fw_string_cnt; s++) {
+                lv_point_t size;
+                lv_txt_get_size(&size, fw_strings[s], font, 0, 0, LV_COORD_MAX, LV_TXT_FLAG_NONE);
+                sink = sink + size.x;
+            }
+        }
+        t = now_us() - t;
+        if(t < best) best = t;
+    }
+    return best;
+}
+
+/*Glyph descriptors of every letter with the next one, like drawing the strings. Best of BENCH_RUNS*/
+static double lookup_strings(const lv_font_t * font)
+{
+    volatile uint16_t sink = 0;
+    double best            = 1e12;
+    uint32_t r, n, s;
+    for(r = 0; r < BENCH_RUNS; r++) {
+        double t = now_us();
+        for(n = 0; n < BENCH_LOOPS; n++) {
+            for(s = 0; s < fw_string_cnt; s++) {
+                const char * c;
+                for(c = fw_strings[s]; *c; c++) {
+                    lv_font_glyph_dsc_t g;
+                    if(lv_font_get_glyph_dsc(font, &g, (uint8_t)c[0], (uint8_t)c[1])) sink = sink + g.adv_w;
+                }
+            }
+        }
+        t = now_us() - t;
+        if(t < best) best = t;
+    }
+    return best;
+}
+
+void test_benchmark(void)
+{
+    uint32_t f;
+    for(f = 0; f < FONT_CNT; f++) {
+        double lookup     = lookup_strings(fonts[f].font);
+        double ref_lookup = lookup_strings(&fonts[f].ref);
+        double size       = measure_strings(fonts[f].font);
+        double ref_size   = measure_strings(&fonts[f].ref);
+        char msg[200];
+        snprintf(msg, sizeof(msg), "%-20s glyph dsc %6.0f us, old %6.0f us (%.2fx)  lv_txt_get_size %6.0f us, old %6.0f us (%.2fx)",
+                 fonts[f].name, lookup, ref_lookup, ref_lookup / lookup, size, ref_size, ref_size / size);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    uint32_t f;
+    for(f = 0; f < FONT_CNT; f++) {
+        ref_font_init(&fonts[f].ref, &fonts[f].ref_dsc, fonts[f].font);
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
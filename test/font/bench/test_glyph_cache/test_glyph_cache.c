@@ -0,0 +1,74 @@
+/**
+ * @file test_glyph_cache.c
+ * Benchmark of the glyph cache of compressed fonts (LV_FONT_GLYPH_CACHE_SIZE): drawing the firmware's
+ * strings with cached bitmaps against decompressing every time (lv_font_fmt_txt_ref.c).
+ * Only prints the times, font/test_glyph_cache checks the bitmaps.
+ *
+ * pio test -e native_bench -f font/bench/test_glyph_cache
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "lv_font_fmt_txt_ref.h"
+
+#define BENCH_LOOPS 200
+
+static lv_font_t ref_font;                   /*the same font with the old lookups*/
+static lv_font_fmt_txt_dsc_t ref_dsc;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*Get the bitmap of every letter of the strings, like drawing them*/
+static double draw_strings(const lv_font_t * font)
+{
+    volatile uint8_t sink = 0;
+    double t              = now_us();
+    uint32_t n, s;
+    for(n = 0; n < BENCH_LOOPS; n++) {
+        for(s = 0; s < fw_string_cnt; s++) {
+            const char * c;
+            for(c = fw_strings[s]; *c; c++) {
+                const uint8_t * bmp = lv_font_get_glyph_bitmap(font, (uint8_t)*c);
+                if(bmp) sink = sink + bmp[0];
+            }
+        }
+    }
+    return now_us() - t;
+}
+
+void test_benchmark(void)
+{
+    lv_font_glyph_cache_clean();
+    double cached = draw_strings(&lv_font_roboto_28_compressed);
+    double fresh  = draw_strings(&ref_font);
+    uint32_t hit, miss;
+    lv_font_glyph_cache_get_stat(&hit, &miss);
+
+    char msg[160];
+    snprintf(msg, sizeof(msg), "roboto 28 compressed: cached %.0f us, decompress every time %.0f us (%.2fx), %u%% hits",
+             cached, fresh, fresh / cached, (unsigned)(hit * 100 / (hit + miss)));
+    TEST_MESSAGE(msg);
+}
+
+int main(void)
+{
+    lv_init();
+    ref_font_init(&ref_font, &ref_dsc, &lv_font_roboto_28_compressed);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,35 @@
+/**
+ * @file lv_font_fmt_txt_ref.c
+ * lv_font_fmt_txt.c again with the caches off and the functions renamed to ref_*, see lv_font_fmt_txt_ref.h
+ */
+#include "lv_conf.h"
+
+#undef LV_FONT_FMT_TXT_CACHE
+#define LV_FONT_FMT_TXT_CACHE 0
+#undef LV_FONT_GLYPH_CACHE_SIZE
+#define LV_FONT_GLYPH_CACHE_SIZE 0
+#define lv_font_get_bitmap_fmt_txt ref_get_bitmap
+#define lv_font_get_glyph_dsc_fmt_txt ref_get_glyph_dsc
+#define lv_font_glyph_cache_get_stat ref_cache_get_stat
+#define lv_font_glyph_cache_clean ref_cache_clean
+#include "lvgl/src/lv_font/lv_font_fmt_txt.c"
+#include "lv_font_fmt_txt_ref.h"
+
+const char * const fw_strings[] = {
+    "Display Options", "Calibrate", "Field Calibration", "Set Target Speed", "Factory Settings", "Reset",
+    "MPH", "km/h", "FPM", "MPM", "0 Feet", "Begin Driving", "Press END", "Save", "Cancel", "Exit",
+    "Password", "Bar Graph", "Alarm", "feet/minute", "Avg/Speed", "Per Pulse", "Adaptive", "Radar",
+    "GPS", "UBX", "Current code = 1234", "Reset password.", "Calibrate touch screen", "Ver 2.2.0",
+    "[ Alarm point = 30.0 ]", "No Calibration needed for GPS Sensor", "0123456789.-",
+};
+const uint32_t fw_string_cnt = sizeof(fw_strings) / sizeof(fw_strings[0]);
+
+void ref_font_init(lv_font_t * ref, lv_font_fmt_txt_dsc_t * ref_dsc, const lv_font_t * font)
+{
+    *ref                  = *font;
+    *ref_dsc              = *(const lv_font_fmt_txt_dsc_t *)font->dsc;
+    ref_dsc->cache        = NULL;
+    ref->dsc              = ref_dsc;
+    ref->get_glyph_bitmap = ref_get_bitmap;
+    ref->get_glyph_dsc    = ref_get_glyph_dsc;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file lv_font_fmt_txt_ref.h
+ * The lookups of lv_font_fmt_txt.c without LV_FONT_FMT_TXT_CACHE and LV_FONT_GLYPH_CACHE_SIZE,
+ * for the tests and benchmarks of test/font to compare the caches with.
+ */
+#ifndef LV_FONT_FMT_TXT_REF_H
+#define LV_FONT_FMT_TXT_REF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl/lvgl.h"
+
+LV_FONT_DECLARE(lv_font_roboto_28_compressed) /*built in lv_conf.h, lv_font.h doesn't declare it*/
+
+const uint8_t * ref_get_bitmap(const lv_font_t * font, uint32_t letter);
+bool ref_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
+                       uint32_t unicode_letter_next);
+void ref_cache_get_stat(uint32_t * hit, uint32_t * miss);
+void ref_cache_clean(void);
+
+/**
+ * Make `ref` the same font as `font` with the lookups above
+ * @param ref the reference font to set up
+ * @param ref_dsc descriptor of `ref`, a copy of `font`'s without cache
+ * @param font a font in the fmt_txt format
+ */
+void ref_font_init(lv_font_t * ref, lv_font_fmt_txt_dsc_t * ref_dsc, const lv_font_t * font);
+
+/*Strings of the firmware's screens*/
+extern const char * const fw_strings[];
+extern const uint32_t fw_string_cnt;
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FONT_FMT_TXT_REF_H*/
@@ -0,0 +1,88 @@
+/**
+ * @file test_font_lookup.c
+ * ASCII glyph id table and kerning cache of fmt_txt fonts (LV_FONT_FMT_TXT_CACHE): glyph descriptors
+ * and text widths against the old cmap and kerning searches of lv_font_fmt_txt_ref.c.
+ * The timing is in bench/test_font_lookup.
+ *
+ * pio test -e native -f font/test_font_lookup
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "lv_font_fmt_txt_ref.h"
+
+typedef struct {
+    const char * name;
+    const lv_font_t * font;
+    lv_font_t ref;                   /*the same font with the old lookups*/
+    lv_font_fmt_txt_dsc_t ref_dsc;
+} font_pair_t;
+
+static font_pair_t fonts[] = {
+    {"Bebasneue", &Bebasneue},
+    {"roboto 16", &lv_font_roboto_16},
+    {"roboto 28", &lv_font_roboto_28},
+    {"roboto 28 compressed", &lv_font_roboto_28_compressed},
+};
+#define FONT_CNT (sizeof(fonts) / sizeof(fonts[0]))
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Every ASCII letter followed by every ASCII letter (kerning) and some letters outside ASCII*/
+void test_glyph_dsc(void)
+{
+    static const uint32_t other[] = {0x1F, 0x7F, 0xB0, 0x2022, 0xF0F3, 0xF00C}; /*0xF0F3: LV_SYMBOL_BELL*/
+    uint32_t f;
+    for(f = 0; f < FONT_CNT; f++) {
+        uint32_t a, b;
+        for(a = 0x20; a <= 0x7E + sizeof(other) / sizeof(other[0]); a++) {
+            uint32_t letter = a <= 0x7E ? a : other[a - 0x7F];
+            for(b = 0x20; b <= 0x7E; b++) {
+                lv_font_glyph_dsc_t g, r;
+                memset(&g, 0, sizeof(g));
+                memset(&r, 0, sizeof(r));
+                bool found     = lv_font_get_glyph_dsc(fonts[f].font, &g, letter, b);
+                bool ref_found = lv_font_get_glyph_dsc(&fonts[f].ref, &r, letter, b);
+                char msg[80];
+                snprintf(msg, sizeof(msg), "%s 0x%x 0x%x", fonts[f].name, (unsigned)letter, (unsigned)b);
+                TEST_ASSERT_EQUAL_MESSAGE(ref_found, found, msg);
+                TEST_ASSERT_EQUAL_MEMORY_MESSAGE(&r, &g, sizeof(g), msg);
+            }
+        }
+    }
+}
+
+/*Same text sizes, lv_txt_get_size measures with kerning*/
+void test_text_size(void)
+{
+    uint32_t f, s;
+    for(f = 0; f < FONT_CNT; f++) {
+        for(s = 0; s < fw_string_cnt; s++) {
+            lv_point_t size, ref_size;
+            lv_txt_get_size(&size, fw_strings[s], fonts[f].font, 0, 0, LV_COORD_MAX, LV_TXT_FLAG_NONE);
+            lv_txt_get_size(&ref_size, fw_strings[s], &fonts[f].ref, 0, 0, LV_COORD_MAX, LV_TXT_FLAG_NONE);
+            TEST_ASSERT_EQUAL_MESSAGE(ref_size.x, size.x, fw_strings[s]);
+            TEST_ASSERT_EQUAL_MESSAGE(ref_size.y, size.y, fw_strings[s]);
+        }
+    }
+}
+
+int main(void)
+{
+    lv_init();
+    uint32_t f;
+    for(f = 0; f < FONT_CNT; f++) {
+        ref_font_init(&fonts[f].ref, &fonts[f].ref_dsc, fonts[f].font);
+    }
+
+    UNITY_BEGIN();
+    RUN_TEST(test_glyph_dsc);
+    RUN_TEST(test_text_size);
+    return UNITY_END();
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test_glyph_cache.c
+ * Glyph cache of compressed fonts (LV_FONT_GLYPH_CACHE_SIZE): cached bitmaps against decompressing
+ * every time with the reference build of lv_font_fmt_txt_ref.c. The timing is in bench/test_glyph_cache.
+ *
+ * pio test -e native -f font/test_glyph_cache
+ */
+#include <string.h>
+#include <unity.h>
+#include "lv_font_fmt_txt_ref.h"
+
+static lv_font_t ref_font;                   /*the same font with the old lookups*/
+static lv_font_fmt_txt_dsc_t ref_dsc;
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Bitmap size as lv_font_get_bitmap_fmt_txt works it out*/
+static uint32_t bitmap_size(const lv_font_glyph_dsc_t * g)
+{
+    uint32_t px = (uint32_t)g->box_w * g->box_h;
+    switch(g->bpp) {
+        case 1: return (px + 7) >> 3;
+        case 2: return (px + 3) >> 2;
+        default: return (px + 1) >> 1;
+    }
+}
+
+/*Same bitmap from the cache as from a fresh decompress, random letters so glyphs are evicted and come back*/
+void test_cached_bitmaps(void)
+{
+    const lv_font_t * font = &lv_font_roboto_28_compressed;
+    uint32_t seed          = 1;
+    uint32_t n;
+    for(n = 0; n < 20000; n++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        uint32_t letter = 0x20 + seed % (0x7F - 0x20);
+        lv_font_glyph_dsc_t g;
+        if(lv_font_get_glyph_dsc(font, &g, letter, 0) == false) continue;
+        uint32_t size = bitmap_size(&g);
+        if(size == 0) continue;
+
+        uint8_t cached[1024];
+        const uint8_t * bmp = lv_font_get_glyph_bitmap(font, letter);
+        TEST_ASSERT_NOT_NULL(bmp);
+        TEST_ASSERT_TRUE(size <= sizeof(cached));
+        memcpy(cached, bmp, size);
+        const uint8_t * fresh = ref_get_bitmap(&ref_font, letter);
+        TEST_ASSERT_NOT_NULL(fresh);
+        TEST_ASSERT_EQUAL_MEMORY(fresh, cached, size);
+    }
+    uint32_t hit, miss;
+    lv_font_glyph_cache_get_stat(&hit, &miss);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, hit);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, miss); /*the 4 kB budget can't hold every glyph*/
+}
+
+int main(void)
+{
+    lv_init();
+    ref_font_init(&ref_font, &ref_dsc, &lv_font_roboto_28_compressed);
+
+    UNITY_BEGIN();
+    RUN_TEST(test_cached_bitmaps);
+    return UNITY_END();
+}
@@ -0,0 +1,78 @@
+/**
+ * @file test_gps_parse.cpp
+ * Benchmark of the NMEA and UBX parsers of the gps task (gps_parse.cpp): characters per second on a
+ * stream of good sentences and NAV-PVT frames. gps/test_gps_parse checks the parsers.
+ *
+ * pio test -e native_bench -f gps/bench/test_gps_parse
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "gps_parse.h"
+#include "gps_make.h"
+
+#define BENCH_BYTES 4000000   //bytes per benchmark run
+#define BENCH_RUNS 10         //the fastest run counts
+#define UART_CPS 11520        //characters per second of a 115200 baud gps
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+static double now_us(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* Characters per second of both parsers on a 5 sentence / 1 frame stream, best of BENCH_RUNS */
+void test_benchmark(void) {
+  static char nmea_stream[BENCH_BYTES];
+  static uint8_t ubx_stream[BENCH_BYTES];
+  int nmea_len = 0;
+  while (nmea_len < BENCH_BYTES - 100) {
+    nmea_len = nmea_len + nmea_make(nmea_stream + nmea_len, BENCH_BYTES - nmea_len, sentences[nmea_len % 4]);
+    }
+  int ubx_len = 0;
+  while (ubx_len < BENCH_BYTES - 100) {
+    ubx_len = ubx_len + pvt_make(ubx_stream + ubx_len, 3, true, ubx_len % 30000, 100);
+    }
+
+  double nmea_best = 1e12, ubx_best = 1e12;
+  uint32_t nmea_cnt = 0, ubx_cnt = 0;
+  for (uint32_t r = 0; r < BENCH_RUNS; r++) {
+    nmea_parser np = {};
+    ubx_parser up = {};
+    nmea_cnt = 0;
+    ubx_cnt = 0;
+    double t = now_us();
+    for (int n = 0; n < nmea_len; n++) {
+      nmea_cnt = nmea_cnt + (nmea_feed(&np, nmea_stream[n]) != nmea_none);
+      }
+    t = now_us() - t;
+    if (t < nmea_best) nmea_best = t;
+    t = now_us();
+    for (int n = 0; n < ubx_len; n++) {
+      ubx_cnt = ubx_cnt + ubx_feed(&up, ubx_stream[n]);
+      }
+    t = now_us() - t;
+    if (t < ubx_best) ubx_best = t;
+    }
+  char msg[160];
+  snprintf(msg, sizeof(msg), "NMEA %5.1f ns/char  %6.1f Mchar/s  %u sentences used (115200 baud is %u char/s)",
+           nmea_best * 1000 / nmea_len, nmea_len / nmea_best, (unsigned)nmea_cnt, (unsigned)UART_CPS);
+  TEST_MESSAGE(msg);
+  snprintf(msg, sizeof(msg), "UBX  %5.1f ns/byte  %6.1f Mbyte/s  %u NAV-PVT frames", ubx_best * 1000 / ubx_len,
+           ubx_len / ubx_best, (unsigned)ubx_cnt);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, nmea_cnt);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, ubx_cnt);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_benchmark);
+  return UNITY_END();
+}
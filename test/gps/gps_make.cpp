@@ -0,0 +1,38 @@
+/**
+ * @file gps_make.cpp
+ * Good NMEA sentences and UBX NAV-PVT frames, see gps_make.h
+ */
+#include <stdio.h>
+#include <string.h>
+#include "gps_parse.h"
+#include "gps_make.h"
+
+const char * const sentences[] = {
+  "$GPRMC,123519.00,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*",
+  "$GNGGA,123519.20,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*",
+  "$GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A*",
+  "$GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00*",
+  "$GPRMC,235959.999,V,,,,,,,,,,N*",
+  "$GPVTG,,T,,M,0.012,N,0.022,K,N*",
+};
+const uint32_t sentence_cnt = sizeof(sentences) / sizeof(sentences[0]);
+
+/* Sentence `body` ("$...*") with its checksum and line end in `out`, returns the length */
+int nmea_make(char * out, size_t size, const char * body) {
+  uint8_t sum = 0;
+  for (const char * c = body + 1; *c != '*'; c++) {
+    sum = sum ^ (uint8_t)*c;
+    }
+  return snprintf(out, size, "%s%02X\r\n", body, sum);
+}
+
+/* NAV-PVT frame with a fix type, fix ok flag, ground speed and speed accuracy */
+uint16_t pvt_make(uint8_t * out, uint8_t fix_type, bool fix_ok, int32_t g_speed, uint32_t s_acc) {
+  uint8_t payload[ubx_nav_pvt_len];
+  memset(payload, 0x5A, sizeof(payload));
+  payload[20] = fix_type;
+  payload[21] = fix_ok ? 0x01 : 0x00;
+  memcpy(&payload[60], &g_speed, 4);                       //little endian on the pc like on the module
+  memcpy(&payload[68], &s_acc, 4);
+  return ubx_frame(out, 0x01, 0x07, payload, sizeof(payload));
+}
@@ -0,0 +1,20 @@
+/**
+ * @file gps_make.h
+ * Good NMEA sentences and UBX NAV-PVT frames for the tests and benchmarks of test/gps
+ */
+#ifndef GPS_MAKE_H
+#define GPS_MAKE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+extern const char * const sentences[];  //"$...*" without checksum, RMC, GGA, VTG, GSV, RMC, VTG
+extern const uint32_t sentence_cnt;
+
+/* Sentence `body` ("$...*") with its checksum and line end in `out`, returns the length */
+int nmea_make(char * out, size_t size, const char * body);
+
+/* NAV-PVT frame with a fix type, fix ok flag, ground speed and speed accuracy in `out`, returns the length */
+uint16_t pvt_make(uint8_t * out, uint8_t fix_type, bool fix_ok, int32_t g_speed, uint32_t s_acc);
+
+#endif
@@ -0,0 +1,298 @@
+/**
+ * @file test_gps_parse.cpp
+ * NMEA and UBX parsers of the gps task (gps_parse.cpp): known sentences and frames, a fuzz run of
+ * broken, cut, joined and random input. The throughput is in bench/test_gps_parse.
+ *
+ * The fuzz run checks that a sentence is only ever returned when its checksum is right, that the
+ * parsers pick up the next good sentence after any garbage, and that the parser state stays in
+ * range. Run it under the address sanitizer for out of bounds reads and writes:
+ *
+ * pio test -e native -f gps/test_gps_parse
+ * pio test -e native_asan -f gps/test_gps_parse
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "gps_parse.h"
+#include "gps_make.h"
+
+#define FUZZ_ROUNDS 200000    //broken sentences and frames per fuzz test
+
+static uint32_t seed = 1;
+
+static uint32_t rnd(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static uint8_t hex(char c) {
+  if (c >= 'a') return c - 'a' + 10;
+  if (c >= 'A') return c - 'A' + 10;
+  return c - '0';
+}
+
+static uint8_t nmea_feed_str(nmea_parser * p, const char * s, int len) {
+  uint8_t last = nmea_none;
+  for (int n = 0; n < len; n++) {
+    uint8_t t = nmea_feed(p, s[n]);
+    if (t != nmea_none) {
+      last = t;
+      }
+    }
+  return last;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_nmea_sentences(void) {
+  nmea_parser p = {};
+  char s[100];
+  int len = nmea_make(s, sizeof(s), sentences[0]);
+  TEST_ASSERT_EQUAL_UINT8(nmea_rmc, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_TRUE(p.fix.valid);
+  TEST_ASSERT_TRUE(p.fix.speed_valid);
+  TEST_ASSERT_EQUAL_INT32(22400, p.fix.speed_mknots);
+  TEST_ASSERT_EQUAL_INT32(84400, p.fix.course_mdeg);
+  TEST_ASSERT_EQUAL_UINT32((12 * 3600 + 35 * 60 + 19) * 1000, p.fix.utc_ms);
+  TEST_ASSERT_EQUAL_INT32(1689383, nmea_mph_q16(&p.fix));  //22.4 knots = 25.78 mph
+
+  len = nmea_make(s, sizeof(s), sentences[1]);
+  TEST_ASSERT_EQUAL_UINT8(nmea_gga, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_EQUAL_UINT8(1, p.fix.quality);
+  TEST_ASSERT_TRUE(p.fix.valid);
+  TEST_ASSERT_EQUAL_UINT32((12 * 3600 + 35 * 60 + 19) * 1000 + 200, p.fix.utc_ms);
+
+  len = nmea_make(s, sizeof(s), sentences[2]);
+  TEST_ASSERT_EQUAL_UINT8(nmea_vtg, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_EQUAL_INT32(5500, p.fix.speed_mknots);
+  TEST_ASSERT_TRUE(p.fix.valid);
+
+  len = nmea_make(s, sizeof(s), sentences[3]);          //good checksum, not a sentence we use
+  TEST_ASSERT_EQUAL_UINT8(nmea_none, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_EQUAL_UINT32(4, p.good);
+
+  len = nmea_make(s, sizeof(s), sentences[4]);
+  TEST_ASSERT_EQUAL_UINT8(nmea_rmc, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_FALSE(p.fix.valid);
+  TEST_ASSERT_FALSE(p.fix.speed_valid);
+  TEST_ASSERT_EQUAL_INT32(0, nmea_mph_q16(&p.fix));
+
+  len = nmea_make(s, sizeof(s), sentences[5]);          //under .5 mph shows 0, mode N is no fix
+  TEST_ASSERT_EQUAL_UINT8(nmea_vtg, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_FALSE(p.fix.valid);
+  TEST_ASSERT_EQUAL_INT32(0, nmea_mph_q16(&p.fix));
+
+  len = nmea_make(s, sizeof(s), sentences[0]);          //wrong checksum
+  s[len - 3] = (s[len - 3] == '0') ? '1' : '0';
+  TEST_ASSERT_EQUAL_UINT8(nmea_none, nmea_feed_str(&p, s, len));
+  TEST_ASSERT_EQUAL_UINT32(1, p.bad);
+
+  char longer[200] = "$GPRMC,";                            //longer than nmea_max_len
+  for (int n = 0; n < 90; n++) {
+    strcat(longer, "1");
+    }
+  strcat(longer, "*");
+  len = nmea_make(s, sizeof(s), sentences[0]);
+  char joined[300];
+  int joined_len = nmea_make(joined, sizeof(joined), longer);
+  memcpy(joined + joined_len, s, len);                     //the next sentence still parses
+  TEST_ASSERT_EQUAL_UINT8(nmea_rmc, nmea_feed_str(&p, joined, joined_len + len));
+}
+
+void test_ubx_frames(void) {
+  ubx_parser p = {};
+  uint8_t f[ubx_nav_pvt_len + 8];
+  uint16_t len = pvt_make(f, 3, true, 11176, 100);         //11.176 m/s = 25 mph
+  bool done = false;
+  for (uint16_t n = 0; n < len; n++) {
+    done = ubx_feed(&p, f[n]);
+    TEST_ASSERT_TRUE(done == (n == len - 1));
+    }
+  TEST_ASSERT_INT_WITHIN(2, 25 * 65536, p.mph_q16);
+  TEST_ASSERT_TRUE(p.locked);
+
+  len = pvt_make(f, 3, true, 11176, ubx_sacc_max + 1);     //speed accuracy too low
+  for (uint16_t n = 0; n < len; n++) {
+    ubx_feed(&p, f[n]);
+    }
+  TEST_ASSERT_FALSE(p.locked);
+
+  len = pvt_make(f, 1, true, -500, 100);                   //dead reckoning only, backwards
+  for (uint16_t n = 0; n < len; n++) {
+    ubx_feed(&p, f[n]);
+    }
+  TEST_ASSERT_FALSE(p.locked);
+  TEST_ASSERT_EQUAL_INT32(0, p.mph_q16);
+
+  len = pvt_make(f, 3, true, 11176, 100);                  //bad checksum
+  f[len - 1] ^= 0x01;
+  done = false;
+  for (uint16_t n = 0; n < len; n++) {
+    if (ubx_feed(&p, f[n])) {
+      done = true;
+      }
+    }
+  TEST_ASSERT_FALSE(done);
+  TEST_ASSERT_EQUAL_UINT32(1, p.bad);
+  TEST_ASSERT_EQUAL_UINT32(3, p.good);
+}
+
+/* One broken version of a good sentence: flipped bits, cut, doubled or random characters */
+static int nmea_break(char * out, const char * good, int len) {
+  memcpy(out, good, len);
+  switch (rnd() % 6) {
+    case 0:                                                //flip bits
+      for (uint32_t n = rnd() % 3 + 1; n > 0; n--) {
+        out[rnd() % len] ^= (char)(1 << (rnd() % 8));
+        }
+      return len;
+    case 1:                                                //cut short
+      return rnd() % len;
+    case 2: {                                              //part of it twice
+      int cut = rnd() % len;
+      memcpy(out + len, good + cut, len - cut);
+      return len + (len - cut);
+      }
+    case 3:                                                //random characters
+      for (int n = 0; n < len; n++) {
+        out[n] = (char)rnd();
+        }
+      return len;
+    case 4:                                                //very long field
+      for (int n = 1; n < len && n < 160; n++) {
+        out[n] = (n % 7 == 0) ? '.' : '9';
+        }
+      return len;
+    default:                                               //good
+      return len;
+    }
+}
+
+/* Sentences are only returned with a good checksum, every good sentence after garbage is found */
+void test_nmea_fuzz(void) {
+  static char stream[400];
+  nmea_parser p = {};
+  uint32_t found = 0, expected = 0;
+  for (uint32_t r = 0; r < FUZZ_ROUNDS; r++) {
+    char good[100];
+    int good_len = nmea_make(good, sizeof(good), sentences[rnd() % sentence_cnt]);
+    int len = nmea_break(stream, good, good_len);
+    uint8_t sum = 0;                                       //checksum of the characters since the last '$'
+    bool in_sentence = false;
+    char prev = 0;
+    for (int n = 0; n < len; n++) {
+      char c = stream[n];
+      uint8_t type = nmea_feed(&p, c);
+      if (c == '$') {
+        sum = 0;
+        in_sentence = true;
+        }
+      else if (c == '*') {
+        in_sentence = false;
+        }
+      else if (in_sentence) {
+        sum = sum ^ (uint8_t)c;
+        }
+      if (type != nmea_none) {
+        TEST_ASSERT_TRUE(type == nmea_rmc || type == nmea_gga || type == nmea_vtg);
+        TEST_ASSERT_EQUAL_HEX8(sum, (uint8_t)((hex(prev) << 4) | hex(c)));   //the two checksum digits
+        }
+      prev = c;
+      TEST_ASSERT_TRUE(p.id_len <= 5);
+      TEST_ASSERT_TRUE(p.state <= 3);
+      TEST_ASSERT_TRUE(p.decimals <= 3 || p.decimals == nmea_no_point);
+      }
+    for (int n = 0; n < good_len; n++) {                   //then a good one
+      if (nmea_feed(&p, good[n]) != nmea_none) {
+        found = found + 1;
+        }
+      }
+    if (strncmp(good + 3, "GSV", 3) != 0) {
+      expected = expected + 1;
+      }
+    }
+  char msg[100];
+  snprintf(msg, sizeof(msg), "%u rounds: %u good, %u bad checksums", (unsigned)FUZZ_ROUNDS, (unsigned)p.good,
+           (unsigned)p.bad);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(expected, found);
+}
+
+/* Frames with broken bytes, lengths and sync never write past the payload, the next good frame is found */
+void test_ubx_fuzz(void) {
+  static uint8_t stream[1200];
+  ubx_parser p = {};
+  uint8_t good[ubx_nav_pvt_len + 8];
+  uint32_t found = 0, frames = 0;                          //good frames after the broken ones, all frames returned
+  for (uint32_t r = 0; r < FUZZ_ROUNDS / 4; r++) {
+    uint16_t good_len = pvt_make(good, rnd() % 5, rnd() % 2, (int32_t)(rnd() % 100000) - 1000, rnd() % 1000);
+    uint16_t len = good_len;
+    memcpy(stream, good, good_len);
+    switch (rnd() % 5) {
+      case 0:                                              //flip bits
+        stream[rnd() % len] ^= (uint8_t)(1 << (rnd() % 8));
+        break;
+      case 1:                                              //cut short
+        len = rnd() % len;
+        break;
+      case 2: {                                            //any length, up to 1000 bytes follow
+        uint16_t claim = (uint16_t)rnd();
+        stream[4] = claim & 0xFF;
+        stream[5] = claim >> 8;
+        len = 6 + rnd() % 1000;
+        for (uint16_t n = 6; n < len; n++) {
+          stream[n] = (uint8_t)rnd();
+          }
+        break;
+        }
+      case 3:                                              //random bytes with sync bytes in them
+        for (uint16_t n = 0; n < len; n++) {
+          stream[n] = (rnd() % 8 == 0) ? 0xB5 : (uint8_t)rnd();
+          }
+        break;
+      default:
+        break;
+      }
+    for (uint16_t n = 0; n < len; n++) {
+      if (ubx_feed(&p, stream[n])) {
+        frames = frames + 1;
+        TEST_ASSERT_TRUE(p.mph_q16 >= 0);
+        }
+      TEST_ASSERT_TRUE(p.state <= 8);
+      }
+    if (p.state >= 2) {                                    //a cut frame waiting for more, resync by its length
+      uint8_t fill[1200];
+      memset(fill, 0, sizeof(fill));
+      for (uint16_t n = 0; n < 520 + 4; n++) {
+        frames = frames + ubx_feed(&p, fill[n]);
+        }
+      }
+    for (uint16_t n = 0; n < good_len; n++) {
+      if (ubx_feed(&p, good[n])) {
+        found = found + 1;
+        }
+      }
+    }
+  frames = frames + found;
+  char msg[100];
+  snprintf(msg, sizeof(msg), "%u rounds: %u good, %u bad checksums", (unsigned)FUZZ_ROUNDS / 4, (unsigned)p.good,
+           (unsigned)p.bad);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_EQUAL_UINT32(FUZZ_ROUNDS / 4, found);
+  TEST_ASSERT_EQUAL_UINT32(frames, p.good);                 //a long frame never writes past the payload into the counters
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_nmea_sentences);
+  RUN_TEST(test_ubx_frames);
+  RUN_TEST(test_nmea_fuzz);
+  RUN_TEST(test_ubx_fuzz);
+  return UNITY_END();
+}
@@ -0,0 +1,77 @@
+/**
+ * @file test_mem_trace.cpp
+ * Benchmark of the lvgl heaps: the heap calls of the firmware's screens (recorded by mem_trace.cpp)
+ * replayed on the first fit and the TLSF heap. Only prints the times, mem/test_mem_trace checks the
+ * replays.
+ *
+ * pio test -e native_bench -f mem/bench/test_mem_trace
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "mem_trace.h"
+
+#define BENCH_RUNS 20         /*the fastest replay counts*/
+
+static void * ptrs[TRACE_MAX + 1];               /*blocks of the replay by id*/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/*The recorded calls without checking, best of BENCH_RUNS*/
+static double replay_timed(const heap_t * h)
+{
+    double best = 1e12;
+    uint32_t r, n;
+    for(r = 0; r < BENCH_RUNS; r++) {
+        h->init();
+        double t = now_us();
+        for(n = 0; n < trace_cnt; n++) {
+            const trace_op_t * op = &trace[n];
+            if(op->old_id == 0) {
+                if(op->new_id) ptrs[op->new_id] = h->alloc(op->size);
+            } else if(op->new_id == 0) {
+                h->free(ptrs[op->old_id]);
+            } else {
+                ptrs[op->new_id] = h->realloc(ptrs[op->old_id], op->size);
+            }
+        }
+        t = now_us() - t;
+        if(t < best) best = t;
+    }
+    return best;
+}
+
+void test_benchmark(void)
+{
+    TEST_ASSERT_FALSE(trace_full);
+    uint32_t h;
+    for(h = 0; h < heap_cnt; h++) {
+        double us = replay_timed(&heaps[h]);
+        char msg[120];
+        snprintf(msg, sizeof(msg), "%-9s %u heap calls %6.0f us (%3.0f ns/call)", heaps[h].name, (unsigned)trace_cnt,
+                 us, us * 1000 / trace_cnt);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    trace_record();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,19 @@
+/**
+ * @file mem_first_fit.c
+ * lv_mem.c again with LV_MEM_TLSF 0 and the functions renamed to ff_*, a second heap for the replays of mem_trace.h
+ */
+#include "lv_conf.h"
+
+#undef LV_MEM_TLSF
+#define LV_MEM_TLSF 0
+#undef LV_MEM_TRACE
+#define LV_MEM_TRACE 0
+#define lv_mem_init ff_mem_init
+#define lv_mem_deinit ff_mem_deinit
+#define lv_mem_alloc ff_mem_alloc
+#define lv_mem_free ff_mem_free
+#define lv_mem_realloc ff_mem_realloc
+#define lv_mem_defrag ff_mem_defrag
+#define lv_mem_monitor ff_mem_monitor
+#define lv_mem_get_size ff_mem_get_size
+#include "lvgl/src/lv_misc/lv_mem.c"
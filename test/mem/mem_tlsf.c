@@ -0,0 +1,19 @@
+/**
+ * @file mem_tlsf.c
+ * lv_mem.c again with LV_MEM_TLSF 1 and the functions renamed to tl_*, a second heap for the replays of mem_trace.h
+ */
+#include "lv_conf.h"
+
+#undef LV_MEM_TLSF
+#define LV_MEM_TLSF 1
+#undef LV_MEM_TRACE
+#define LV_MEM_TRACE 0
+#define lv_mem_init tl_mem_init
+#define lv_mem_deinit tl_mem_deinit
+#define lv_mem_alloc tl_mem_alloc
+#define lv_mem_free tl_mem_free
+#define lv_mem_realloc tl_mem_realloc
+#define lv_mem_defrag tl_mem_defrag
+#define lv_mem_monitor tl_mem_monitor
+#define lv_mem_get_size tl_mem_get_size
+#include "lvgl/src/lv_misc/lv_mem.c"
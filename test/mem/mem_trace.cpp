@@ -0,0 +1,133 @@
+/**
+ * @file mem_trace.cpp
+ * Records the lvgl heap calls of the firmware's screens for the replays of test_mem_trace and
+ * bench/test_mem_trace, see mem_trace.h
+ */
+#include "app.h"
+#include <EEPROM.h>
+#include "mem_trace.h"
+
+#if LV_MEM_TRACE == 0
+#error "mem_trace.cpp needs LV_MEM_TRACE 1 (set in env:native)"
+#endif
+
+#define LIVE_MAX 4096         /*blocks allocated at the same time*/
+
+extern "C" {
+void ff_mem_init(void);
+void * ff_mem_alloc(size_t size);
+void ff_mem_free(const void * data);
+void * ff_mem_realloc(void * data_p, size_t new_size);
+void ff_mem_monitor(lv_mem_monitor_t * mon_p);
+void tl_mem_init(void);
+void * tl_mem_alloc(size_t size);
+void tl_mem_free(const void * data);
+void * tl_mem_realloc(void * data_p, size_t new_size);
+void tl_mem_monitor(lv_mem_monitor_t * mon_p);
+}
+
+const heap_t heaps[] = {
+    {"first fit", ff_mem_init, ff_mem_alloc, ff_mem_free, ff_mem_realloc, ff_mem_monitor},
+    {"TLSF", tl_mem_init, tl_mem_alloc, tl_mem_free, tl_mem_realloc, tl_mem_monitor},
+};
+const uint32_t heap_cnt = sizeof(heaps) / sizeof(heaps[0]);
+
+trace_op_t trace[TRACE_MAX];
+uint32_t trace_cnt;
+uint32_t trace_live_cnt;
+bool trace_full;
+static uint32_t trace_ids;                       /*the last id given to a block*/
+static const void * live_p[LIVE_MAX];            /*blocks of the recorded heap and their ids*/
+static uint32_t live_id[LIVE_MAX];
+
+/*Id of a block of the recorded heap and forget it, 0 if it's not known (zero size or freed before)*/
+static uint32_t live_take(const void * p)
+{
+    uint32_t i;
+    for(i = 0; i < trace_live_cnt; i++) {
+        if(live_p[i] == p) {
+            uint32_t id = live_id[i];
+            trace_live_cnt--;
+            live_p[i]  = live_p[trace_live_cnt];
+            live_id[i] = live_id[trace_live_cnt];
+            return id;
+        }
+    }
+    return 0;
+}
+
+static uint32_t live_add(const void * p)
+{
+    if(trace_live_cnt >= LIVE_MAX) {
+        trace_full = true;
+        return 0;
+    }
+    live_p[trace_live_cnt]  = p;
+    live_id[trace_live_cnt] = ++trace_ids;
+    return live_id[trace_live_cnt++];
+}
+
+static void trace_cb(const void * old_p, const void * new_p, size_t size)
+{
+    if(trace_cnt >= TRACE_MAX) {
+        trace_full = true;
+        return;
+    }
+    if(old_p == NULL && new_p == NULL) return; /*failed allocation*/
+    if(old_p != NULL && new_p == NULL && size != 0) return; /*failed reallocation, the old block stays*/
+
+    trace_op_t * op = &trace[trace_cnt];
+    op->old_id      = old_p ? live_take(old_p) : 0;
+    if(old_p != NULL && op->old_id == 0 && new_p == NULL) return; /*free of a zero size block*/
+    op->new_id = new_p ? live_add(new_p) : 0;
+    op->size   = size;
+    trace_cnt++;
+}
+
+/*Settings of a new unit, like the native env starts with*/
+static void settings_defaults(void)
+{
+    units = 1;
+    dis = 1;
+    graph = 1;
+    fpm = 1;
+    speed_avg = filter_none;
+    speed_target = 30.0;
+    cal_number = 1000;
+    old_cal_number = cal_number;
+    ALR1 = 1.0;
+    ALR2 = 2.0;
+    ALR3 = 3.0;
+    ALR4 = 4.0;
+    user_passcode = "1234E";
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    (void)area;
+    (void)color_p;
+    lv_disp_flush_ready(drv);
+}
+
+void trace_record(void)
+{
+    static lv_disp_buf_t disp_buf;
+    static lv_color_t buf[LV_HOR_RES_MAX * 10];
+
+    lv_mem_set_trace_cb(trace_cb); /*from the first allocation*/
+    lv_init();
+    EEPROM.begin(200);
+    lv_disp_buf_init(&disp_buf, buf, NULL, LV_HOR_RES_MAX * 10);
+    lv_disp_drv_t drv;
+    lv_disp_drv_init(&drv);
+    drv.hor_res  = LV_HOR_RES_MAX;
+    drv.ver_res  = LV_VER_RES_MAX;
+    drv.flush_cb = flush_cb;
+    drv.buffer   = &disp_buf;
+    lv_disp_drv_register(&drv);
+
+    settings_defaults();
+    build_screens();
+    scen_run(false);
+    lv_mem_set_trace_cb(NULL);
+}
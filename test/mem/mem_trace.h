@@ -0,0 +1,43 @@
+/**
+ * @file mem_trace.h
+ * The lvgl heap calls of the firmware's screens recorded with LV_MEM_TRACE, and the first fit and TLSF
+ * heaps of mem_first_fit.c and mem_tlsf.c to replay them on. The recording needs the native env's
+ * LV_MEM_TRACE 1.
+ */
+#ifndef MEM_TRACE_H
+#define MEM_TRACE_H
+
+#include "lvgl/lvgl.h"
+
+#define TRACE_MAX 200000      /*heap calls the recording can hold*/
+
+typedef struct {
+    uint32_t old_id; /*0: allocation*/
+    uint32_t new_id; /*0: free*/
+    uint32_t size;
+} trace_op_t;
+
+typedef struct {
+    const char * name;
+    void (*init)(void);
+    void * (*alloc)(size_t size);
+    void (*free)(const void * data);
+    void * (*realloc)(void * data_p, size_t new_size);
+    void (*monitor)(lv_mem_monitor_t * mon_p);
+} heap_t;
+
+extern const heap_t heaps[];
+extern const uint32_t heap_cnt;
+
+extern trace_op_t trace[TRACE_MAX];
+extern uint32_t trace_cnt;
+extern uint32_t trace_live_cnt;  /*blocks still allocated at the end*/
+extern bool trace_full;          /*calls were lost, TRACE_MAX or the live block list was too small*/
+
+/**
+ * lv_init, build_screens and the render scenarios of serial 's' with every heap call recorded in `trace`.
+ * Blocks are numbered from 1 in the order they were allocated.
+ */
+void trace_record(void);
+
+#endif /*MEM_TRACE_H*/
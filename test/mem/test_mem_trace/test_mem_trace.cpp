@@ -0,0 +1,141 @@
+/**
+ * @file test_mem_trace.cpp
+ * Replays the lvgl heap calls of the firmware's screens (recorded by mem_trace.cpp) on a first fit and
+ * a TLSF heap: every block keeps its content, and the fragmentation of both. The time per call is
+ * in bench/test_mem_trace.
+ *
+ * mem_first_fit.c and mem_tlsf.c compile lv_mem.c again with their own heap of LV_MEM_SIZE,
+ * so the replays don't touch the heap the screens live in.
+ *
+ * pio test -e native -f mem/test_mem_trace
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "mem_trace.h"
+
+#define MON_PERIOD 64         /*calls between two lv_mem_monitor of the checked replay*/
+
+static uint8_t * ptrs[TRACE_MAX + 1];            /*blocks of the replay by id*/
+static uint32_t sizes[TRACE_MAX + 1];
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Every byte of a replayed block is its id*/
+static void block_fill(uint32_t id)
+{
+    memset(ptrs[id], (uint8_t)id, sizes[id]);
+}
+
+static void block_check(uint32_t id, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        if(ptrs[id][i] != (uint8_t)id) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "block %u byte %u", (unsigned)id, (unsigned)i);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+/*The worst heap state seen during a replay*/
+typedef struct {
+    uint32_t free_cnt;
+    uint32_t biggest_min;
+    uint8_t frag_pct;
+    lv_mem_monitor_t end;
+} heap_stat_t;
+
+static void replay_checked(const heap_t * h, heap_stat_t * st)
+{
+    memset(st, 0, sizeof(heap_stat_t));
+    st->biggest_min = UINT32_MAX;
+    memset(ptrs, 0, sizeof(ptrs));
+    h->init();
+
+    uint32_t n;
+    for(n = 0; n < trace_cnt; n++) {
+        const trace_op_t * op = &trace[n];
+        if(op->old_id == 0) {
+            if(op->new_id == 0) continue; /*allocation of a block that didn't fit in the live list*/
+            ptrs[op->new_id]  = (uint8_t *)h->alloc(op->size);
+            sizes[op->new_id] = op->size;
+            TEST_ASSERT_NOT_NULL_MESSAGE(ptrs[op->new_id], h->name);
+            block_fill(op->new_id);
+        } else if(op->new_id == 0) {
+            block_check(op->old_id, sizes[op->old_id]);
+            h->free(ptrs[op->old_id]);
+            ptrs[op->old_id] = NULL;
+        } else {
+            uint32_t keep = LV_MATH_MIN(sizes[op->old_id], op->size);
+            block_check(op->old_id, sizes[op->old_id]);
+            ptrs[op->new_id]  = (uint8_t *)h->realloc(ptrs[op->old_id], op->size);
+            sizes[op->new_id] = op->size;
+            ptrs[op->old_id]  = NULL;
+            TEST_ASSERT_NOT_NULL_MESSAGE(ptrs[op->new_id], h->name);
+            uint32_t i;
+            for(i = 0; i < keep; i++) TEST_ASSERT_EQUAL_UINT8((uint8_t)op->old_id, ptrs[op->new_id][i]);
+            block_fill(op->new_id);
+        }
+
+        if(n % MON_PERIOD == 0) {
+            lv_mem_monitor_t mon;
+            h->monitor(&mon);
+            if(mon.free_cnt > st->free_cnt) st->free_cnt = mon.free_cnt;
+            if(mon.free_biggest_size < st->biggest_min) st->biggest_min = mon.free_biggest_size;
+            if(mon.frag_pct > st->frag_pct) st->frag_pct = mon.frag_pct;
+        }
+    }
+    h->monitor(&st->end);
+}
+
+/*The recording has the screens' calls: lots of them, all kinds and all of them kept*/
+void test_trace(void)
+{
+    uint32_t n, alloc = 0, free = 0, realloc = 0;
+    for(n = 0; n < trace_cnt; n++) {
+        if(trace[n].old_id == 0) alloc++;
+        else if(trace[n].new_id == 0) free++;
+        else realloc++;
+    }
+    char msg[120];
+    snprintf(msg, sizeof(msg), "%u heap calls: %u alloc, %u free, %u realloc, %u blocks left",
+             (unsigned)trace_cnt, (unsigned)alloc, (unsigned)free, (unsigned)realloc, (unsigned)trace_live_cnt);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_FALSE(trace_full);
+    TEST_ASSERT_GREATER_THAN_UINT32(100, free);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, realloc);
+}
+
+void test_replay(void)
+{
+    uint32_t h;
+    for(h = 0; h < heap_cnt; h++) {
+        heap_stat_t st;
+        replay_checked(&heaps[h], &st);
+        char msg[200];
+        snprintf(msg, sizeof(msg),
+                 "%-9s worst: %3u free blocks, biggest free %5u, frag %2u%%  end: %u used, max used %u",
+                 heaps[h].name, (unsigned)st.free_cnt, (unsigned)st.biggest_min,
+                 (unsigned)st.frag_pct, (unsigned)(st.end.total_size - st.end.free_size),
+                 (unsigned)st.end.max_used);
+        TEST_MESSAGE(msg);
+    }
+}
+
+int main(void)
+{
+    trace_record();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_trace);
+    RUN_TEST(test_replay);
+    return UNITY_END();
+}
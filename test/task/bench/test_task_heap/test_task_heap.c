@@ -0,0 +1,80 @@
+/**
+ * @file test_task_heap.c
+ * Benchmark of the deadline heap of lv_task.c: lv_task_handler() calls with nothing to do against the
+ * handler of lv_task_ref.c that scans the task list on every call. Only prints the times,
+ * task/test_task_heap checks that both run the same tasks.
+ *
+ * pio test -e native_bench -f task/bench/test_task_heap
+ */
+#include <stdio.h>
+#include <time.h>
+#include <unity.h>
+#include "lvgl/lvgl.h"
+#include "lv_task_ref.h"
+
+#define BENCH_CALLS 200000    /*handler calls with nothing due*/
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void idle_cb(lv_task_t * task)
+{
+    (void)task;
+}
+
+static double idle_calls(void (*handler)(void))
+{
+    double t = now_us();
+    uint32_t n;
+    for(n = 0; n < BENCH_CALLS; n++) handler();
+    return now_us() - t;
+}
+
+/*Handler calls between two frames: the firmware's tasks (refresh, input, animations, screen tasks) and none is due*/
+void test_benchmark(void)
+{
+    static const uint32_t task_cnt[] = {6, 12, 24};
+    uint32_t c;
+    for(c = 0; c < sizeof(task_cnt) / sizeof(task_cnt[0]); c++) {
+        lv_task_t * heap_tasks[24];
+        lv_task_t * scan_tasks[24];
+        uint32_t i;
+        for(i = 0; i < task_cnt[c]; i++) {
+            heap_tasks[i] = lv_task_create(idle_cb, 1000000, LV_TASK_PRIO_LOWEST + i % 5, NULL);
+            scan_tasks[i] = ref_task_create(idle_cb, 1000000, LV_TASK_PRIO_LOWEST + i % 5, NULL);
+        }
+        double heap_us = idle_calls(lv_task_handler);
+        double scan_us = idle_calls(ref_task_handler);
+        char msg[128];
+        snprintf(msg, sizeof(msg), "%2u tasks, nothing due: heap %5.1f ns/call, scan %5.1f ns/call (%.1fx)",
+                 (unsigned)task_cnt[c], heap_us * 1000 / BENCH_CALLS, scan_us * 1000 / BENCH_CALLS, scan_us / heap_us);
+        TEST_MESSAGE(msg);
+        for(i = 0; i < task_cnt[c]; i++) {
+            lv_task_del(heap_tasks[i]);
+            ref_task_del(scan_tasks[i]);
+        }
+    }
+}
+
+int main(void)
+{
+    lv_mem_init();
+    lv_task_core_init();
+    ref_task_scan_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_benchmark);
+    return UNITY_END();
+}
@@ -0,0 +1,36 @@
+/**
+ * @file lv_task_ref.c
+ * lv_task.c again with its own task list and the functions renamed to ref_task_*, see lv_task_ref.h
+ */
+#include "lv_conf.h"
+
+/*Renamed before lv_task.h is included so it declares the ref_task_* functions*/
+#define lv_task_core_init ref_task_core_init
+#define lv_task_handler ref_task_handler
+#define lv_task_create_basic ref_task_create_basic
+#define lv_task_create ref_task_create
+#define lv_task_del ref_task_del
+#define lv_task_set_cb ref_task_set_cb
+#define lv_task_set_prio ref_task_set_prio
+#define lv_task_set_period ref_task_set_period
+#define lv_task_ready ref_task_ready
+#define lv_task_once ref_task_once
+#define lv_task_reset ref_task_reset
+#define lv_task_enable ref_task_enable
+#define lv_task_get_idle ref_task_get_idle
+#define lv_task_get_next_deadline ref_task_get_next_deadline
+#include "lvgl/src/lv_misc/lv_task.h"
+#include "lvgl/src/lv_misc/lv_gc.h"
+
+#undef LV_GC_ROOT
+#define LV_GC_ROOT(x) ref##x
+static lv_ll_t ref_lv_task_ll;
+static void * ref_lv_task_act;
+#include "lvgl/src/lv_misc/lv_task.c"
+#include "lv_task_ref.h"
+
+void ref_task_scan_init(void)
+{
+    ref_task_core_init();
+    heap_err = true; /*the fallback of lv_task_handler if the heap can't grow*/
+}
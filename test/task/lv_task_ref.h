@@ -0,0 +1,40 @@
+/**
+ * @file lv_task_ref.h
+ * A second lv_task.c with its own task list, for the tests and benchmarks of test/task to compare the
+ * deadline heap with. After ref_task_scan_init() its handler scans the task list on every call
+ * like lv_task_handler() did before the heap.
+ */
+#ifndef LV_TASK_REF_H
+#define LV_TASK_REF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "lvgl/lvgl.h"
+
+void ref_task_core_init(void);
+LV_ATTRIBUTE_TASK_HANDLER void ref_task_handler(void);
+lv_task_t * ref_task_create_basic(void);
+lv_task_t * ref_task_create(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_t prio, void * user_data);
+void ref_task_del(lv_task_t * task);
+void ref_task_set_cb(lv_task_t * task, lv_task_cb_t task_cb);
+void ref_task_set_prio(lv_task_t * task, lv_task_prio_t prio);
+void ref_task_set_period(lv_task_t * task, uint32_t period);
+void ref_task_ready(lv_task_t * task);
+void ref_task_once(lv_task_t * task);
+void ref_task_reset(lv_task_t * task);
+void ref_task_enable(bool en);
+uint8_t ref_task_get_idle(void);
+uint32_t ref_task_get_next_deadline(void);
+
+/**
+ * ref_task_core_init() and set the copy's `heap_err`, so its handler scans the task list on every call
+ */
+void ref_task_scan_init(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_TASK_REF_H*/
@@ -0,0 +1,214 @@
+/**
+ * @file test_task_heap.c
+ * Deadline heap of lv_task.c: the same random task load on the scheduler with the heap and on one that
+ * scans the task list on every lv_task_handler() call like before. Both must run the same tasks in the
+ * same order on every tick, and lv_task_get_next_deadline() must match a scan of the tasks.
+ * The timing is in bench/test_task_heap.
+ *
+ * The scheduler that scans is the second lv_task.c of lv_task_ref.c with its own task list.
+ *
+ * pio test -e native -f task/test_task_heap
+ */
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "lvgl/lvgl.h"
+#include "lvgl/src/lv_misc/lv_gc.h"
+#include "lv_task_ref.h"
+
+#define TASK_CNT 12           /*long lived tasks*/
+#define SIM_MS 200000         /*simulated time*/
+#define ONCE_ID 100           /*user data of the one shot tasks starts here*/
+
+typedef struct {
+    const char * name;
+    void (*handler)(void);
+    lv_task_t * (*create)(lv_task_cb_t task_xcb, uint32_t period, lv_task_prio_t prio, void * user_data);
+    void (*del)(lv_task_t * task);
+    void (*set_prio)(lv_task_t * task, lv_task_prio_t prio);
+    void (*set_period)(lv_task_t * task, uint32_t period);
+    void (*ready)(lv_task_t * task);
+    void (*once)(lv_task_t * task);
+    void (*reset)(lv_task_t * task);
+} sched_t;
+
+/*One run of the task load*/
+typedef struct {
+    const sched_t * s;
+    lv_task_t * tasks[TASK_CNT];
+    lv_task_prio_t prio[TASK_CNT]; /*priority to go back to after a stop*/
+    uint32_t seed;
+    uint32_t hash;                 /*tasks run in this tick*/
+    uint32_t runs;
+    uint32_t once_cnt;             /*one shot tasks created*/
+} load_t;
+
+static const sched_t heap_sched = {"heap", lv_task_handler, lv_task_create, lv_task_del, lv_task_set_prio,
+                                   lv_task_set_period, lv_task_ready, lv_task_once, lv_task_reset};
+static const sched_t scan_sched = {"scan", ref_task_handler, ref_task_create, ref_task_del, ref_task_set_prio,
+                                   ref_task_set_period, ref_task_ready, ref_task_once, ref_task_reset};
+
+static const uint32_t periods[] = {0, 1, 2, 5, 10, 20, 30, 33, 50, 100, 500};
+#define PERIOD_CNT (sizeof(periods) / sizeof(periods[0]))
+
+static load_t * load; /*the load whose handler is running*/
+
+static uint32_t rnd(load_t * l)
+{
+    l->seed ^= l->seed << 13;
+    l->seed ^= l->seed >> 17;
+    l->seed ^= l->seed << 5;
+    return l->seed;
+}
+
+static lv_task_prio_t rnd_prio(load_t * l)
+{
+    return LV_TASK_PRIO_LOWEST + rnd(l) % (LV_TASK_PRIO_HIGHEST - LV_TASK_PRIO_LOWEST + 1);
+}
+
+static void log_run(uint32_t id)
+{
+    load->hash = (load->hash ^ id) * 16777619UL;
+    load->runs++;
+}
+
+static void once_cb(lv_task_t * task)
+{
+    log_run((uint32_t)(uintptr_t)task->user_data);
+}
+
+/*Change something of a task: what the firmware's screens and lvgl's own tasks do*/
+static void change(load_t * l)
+{
+    const sched_t * s = l->s;
+    uint32_t i        = rnd(l) % TASK_CNT;
+    lv_task_t * t     = l->tasks[i];
+    switch(rnd(l) % 6) {
+        case 0: s->set_period(t, periods[rnd(l) % PERIOD_CNT]); break;
+        case 1: s->reset(t); break;
+        case 2: s->ready(t); break;
+        case 3: /*stop or start again*/
+            if(t->prio == LV_TASK_PRIO_OFF) s->set_prio(t, l->prio[i]);
+            else s->set_prio(t, LV_TASK_PRIO_OFF);
+            break;
+        case 4:
+            if(t->prio != LV_TASK_PRIO_OFF) {
+                l->prio[i] = rnd_prio(l);
+                s->set_prio(t, l->prio[i]);
+            }
+            break;
+        case 5: {
+            lv_task_t * o = s->create(once_cb, periods[rnd(l) % PERIOD_CNT], rnd_prio(l),
+                                      (void *)(uintptr_t)(ONCE_ID + l->once_cnt++));
+            s->once(o);
+            break;
+        }
+    }
+}
+
+static void task_cb(lv_task_t * task)
+{
+    log_run((uint32_t)(uintptr_t)task->user_data);
+    if(rnd(load) % 8 == 0) change(load);
+}
+
+static void load_init(load_t * l, const sched_t * s)
+{
+    memset(l, 0, sizeof(load_t));
+    l->s    = s;
+    l->seed = 12345;
+    uint32_t i;
+    for(i = 0; i < TASK_CNT; i++) {
+        l->prio[i]  = rnd_prio(l);
+        l->tasks[i] = s->create(task_cb, periods[rnd(l) % PERIOD_CNT], l->prio[i], (void *)(uintptr_t)i);
+    }
+}
+
+/*Time until the next task is due by looking at every task*/
+static uint32_t scan_deadline(void)
+{
+    uint32_t next = LV_TASK_NO_DEADLINE;
+    lv_task_t * t;
+    LV_LL_READ(LV_GC_ROOT(_lv_task_ll), t) {
+        if(t->prio == LV_TASK_PRIO_OFF) continue;
+        uint32_t elp  = lv_tick_elaps(t->last_run);
+        uint32_t wait = elp >= t->period ? 0 : t->period - elp;
+        if(wait < next) next = wait;
+    }
+    return next;
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+/*Same tasks in the same order on every tick. The handler is called 1 to 7 ms apart like loop() does*/
+void test_same_runs(void)
+{
+    static load_t heap_load, scan_load;
+    load_init(&heap_load, &heap_sched);
+    load_init(&scan_load, &scan_sched);
+
+    uint32_t ms, gap = 0, handler_calls = 0;
+    for(ms = 0; ms < SIM_MS; ms++) {
+        lv_tick_inc(1);
+        if(gap > 0) {
+            gap--;
+            continue;
+        }
+        gap = rnd(&heap_load) % 7;
+        rnd(&scan_load);
+
+        /*Changes from outside the tasks, like the screens between two handler calls*/
+        if(rnd(&heap_load) % 16 == 0) {
+            rnd(&scan_load);
+            change(&heap_load);
+            change(&scan_load);
+        } else {
+            rnd(&scan_load);
+        }
+
+        heap_load.hash = 2166136261UL;
+        scan_load.hash = 2166136261UL;
+        load           = &heap_load;
+        lv_task_handler();
+        load = &scan_load;
+        ref_task_handler();
+        handler_calls++;
+
+        if(heap_load.hash != scan_load.hash) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "different tasks run at %u ms", (unsigned)ms);
+            TEST_FAIL_MESSAGE(msg);
+        }
+        TEST_ASSERT_EQUAL_UINT32(scan_deadline(), lv_task_get_next_deadline());
+    }
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%u handler calls, %u task runs, %u one shot tasks", (unsigned)handler_calls,
+             (unsigned)heap_load.runs, (unsigned)heap_load.once_cnt);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_EQUAL_UINT32(scan_load.runs, heap_load.runs);
+    TEST_ASSERT_GREATER_THAN_UINT32(1000, heap_load.once_cnt);
+
+    uint32_t i;
+    for(i = 0; i < TASK_CNT; i++) {
+        lv_task_del(heap_load.tasks[i]);
+        ref_task_del(scan_load.tasks[i]);
+    }
+}
+
+int main(void)
+{
+    lv_mem_init();
+    lv_task_core_init();
+    ref_task_scan_init();
+
+    UNITY_BEGIN();
+    RUN_TEST(test_same_runs);
+    return UNITY_END();
+}
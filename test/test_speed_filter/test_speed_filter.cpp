@@ -0,0 +1,271 @@
+/**
+ * @file test_speed_filter.cpp
+ * Lag and noise of the speed filters (speed_math.cpp) at the times between readings of every speed
+ * mode: per pulse (about 1ms), adaptive gate (50ms to 1s) and the fixed 250ms gate. The kalman
+ * filter with the gains of its time bucket is compared with the single set of gains worked out for
+ * 250ms that it used before.
+ *
+ * noise: rms error at a steady 20 mph with 0.3 mph of gaussian noise on the readings, % of the rms
+ *        error of the readings themselves
+ * step:  time until the output is within 2% after a 20 to 24 mph step (no noise)
+ * ramp:  lag behind a 5 mph/s hard launch, error / rate once the filter has caught up (no noise)
+ *
+ * pio test -e native -f test_speed_filter
+ */
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "speed_math.h"
+
+#define NOISE_MPH 0.3f        //sqrt(kalman_r)
+#define JITTER_PCT 10         //time between readings varies +-10%
+#define STEADY_US 60000000LL  //steady speed run (60s)
+#define SETTLE_US 10000000LL  //not counted at the start of the steady run
+#define STEP_MAX_US 10000000LL
+#define RAMP_RATE 5.0f        //mph per second
+#define RAMP_US 8000000LL     //0 to 40 mph, lag measured in the second half
+#define BUCKET_READINGS 4000  //readings per kalman bucket in test_bucket_noise
+
+static const int32_t intervals[] = {1000, 50000, 250000, 1000000};
+static const char * const interval_names[] = {"per pulse 1ms", "adaptive 50ms", "fixed 250ms", "adaptive 1s"};
+#define INTERVAL_CNT (sizeof(intervals) / sizeof(intervals[0]))
+
+#define KALMAN_OLD 100        //kalman with the 250ms gains for every reading
+
+static const uint8_t types[] = {filter_iir, filter_alpha_beta, KALMAN_OLD, filter_kalman, filter_median_kalman};
+static const char * const type_names[] = {"iir", "alpha-beta", "kalman 250ms gains", "kalman", "median + kalman"};
+#define TYPE_CNT (sizeof(types) / sizeof(types[0]))
+
+static kalman_gain old_gains;
+static uint32_t seed = 1;
+
+static uint32_t rnd(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static float gauss(void) {                         //box-muller
+  double u1 = (rnd() + 1.0) / 4294967297.0;
+  double u2 = (rnd() + 1.0) / 4294967297.0;
+  return (float)(sqrt(-2 * log(u1)) * cos(2 * M_PI * u2));
+}
+
+static int32_t next_dt(int32_t interval) {
+  int32_t spread = interval * JITTER_PCT / 100;
+  return interval - spread + (int32_t)(rnd() % (2 * spread + 1));
+}
+
+static int32_t q16(float mph) {
+  return (int32_t)lroundf(mph * 65536);
+}
+
+/* One reading through filter `type`, KALMAN_OLD runs kalman_step with old_gains like speed_average did */
+static float filter_run(speed_filter_state * f, uint8_t type, float mph, int32_t dt) {
+  if (type != KALMAN_OLD) {
+    return (float)speed_filter(f, type, q16(mph), dt) / 65536;
+    }
+  if (f->valid == false) {
+    speed_filter(f, filter_kalman, q16(mph), dt);
+    return mph;
+    }
+  kalman_step(f, q16(mph), dt, &old_gains);
+  if (f->x < 0) {
+    f->x = 0;
+    }
+  return (float)f->x / 65536;
+}
+
+struct filter_result {
+  float noise;                                     //rms mph
+  float raw;                                       //rms mph of the readings
+  float step_ms;
+  float ramp_ms;
+};
+
+static filter_result measure(uint8_t type, int32_t interval) {
+  filter_result res;
+  speed_filter_state f;
+  seed = 12345;
+
+  speed_filter_reset(&f);                          //noise
+  double sq = 0;
+  double raw_sq = 0;
+  uint32_t n = 0;
+  for (int64_t t = 0; t < STEADY_US; ) {
+    int32_t dt = next_dt(interval);
+    t = t + dt;
+    float mph = 20 + NOISE_MPH * gauss();
+    float out = filter_run(&f, type, mph, dt);
+    if (t >= SETTLE_US) {
+      float z = (float)q16(mph) / 65536;           //the reading as the filter gets it
+      sq = sq + (out - 20.0) * (out - 20.0);
+      raw_sq = raw_sq + (z - 20.0) * (z - 20.0);
+      n = n + 1;
+      }
+    }
+  res.noise = (float)sqrt(sq / n);
+  res.raw = (float)sqrt(raw_sq / n);
+
+  speed_filter_reset(&f);                          //step
+  for (int64_t t = 0; t < SETTLE_US; ) {
+    int32_t dt = next_dt(interval);
+    t = t + dt;
+    filter_run(&f, type, 20, dt);
+    }
+  res.step_ms = STEP_MAX_US / 1000;
+  for (int64_t t = 0; t < STEP_MAX_US; ) {
+    int32_t dt = next_dt(interval);
+    t = t + dt;
+    if (fabsf(filter_run(&f, type, 24, dt) - 24) <= 24 * 0.02f) {
+      res.step_ms = (float)t / 1000;
+      break;
+      }
+    }
+
+  speed_filter_reset(&f);                          //ramp
+  double lag = 0;
+  n = 0;
+  filter_run(&f, type, 0, interval);
+  for (int64_t t = 0; t < RAMP_US; ) {
+    int32_t dt = next_dt(interval);
+    t = t + dt;
+    float mph = RAMP_RATE * t / 1000000;
+    float out = filter_run(&f, type, mph, dt);
+    if (t >= RAMP_US / 2) {
+      lag = lag + (mph - out) / RAMP_RATE * 1000;
+      n = n + 1;
+      }
+    }
+  res.ramp_ms = (float)(lag / n);
+  return res;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* The gains settle at every bucket: 1ms needed far more than the 200 riccati steps used before */
+void test_gains(void) {
+  const kalman_gain * g = kalman_gain_for(1000);   //double precision values of the steady state
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 0.01228f, 0.01228f, g->k1 / 65536.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 0.0758f, 0.0758f, g->k2 / 65536.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 0.234f, 0.234f, g->k3 / 65536.0f);
+  g = kalman_gain_for(256000);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 0.715f, 0.715f, g->k1 / 65536.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 1.697f, 1.697f, g->k2 / 65536.0f);
+  TEST_ASSERT_FLOAT_WITHIN(0.02f * 2.013f, 2.013f, g->k3 / 65536.0f);
+
+  TEST_ASSERT_TRUE(kalman_gain_for(1) == kalman_gain_for(1000));   //nearest bucket
+  TEST_ASSERT_TRUE(kalman_gain_for(1400) == kalman_gain_for(1000));
+  TEST_ASSERT_TRUE(kalman_gain_for(1500) == kalman_gain_for(2000));
+  TEST_ASSERT_TRUE(kalman_gain_for(50000) == kalman_gain_for(64000));
+  TEST_ASSERT_TRUE(kalman_gain_for(2000000) == kalman_gain_for(1024000));
+
+  g = kalman_gain_for(1024000);                    //1s gains would keep 98% of the noise, readings pass through
+  TEST_ASSERT_EQUAL_INT32(65536, g->k1);
+  TEST_ASSERT_EQUAL_INT32(0, g->k2);
+  TEST_ASSERT_EQUAL_INT32(0, g->k3);
+}
+
+/* Every filter at every time between readings. The kalman gains of the bucket have to filter the
+   noise at least as well as the 250ms gains did, the per pulse readings much better, and never leave
+   more noise than the readings had. At 1s the readings pass through */
+void test_lag_noise(void) {
+  for (uint32_t i = 0; i < INTERVAL_CNT; i++) {
+    filter_result old = {NOISE_MPH, 0, 0};
+    for (uint32_t k = 0; k < TYPE_CNT; k++) {
+      filter_result r = measure(types[k], intervals[i]);
+      char msg[160];
+      snprintf(msg, sizeof(msg), "%-13s %-18s noise %5.3f mph (%3.0f%%)  step %6.0f ms  ramp lag %6.0f ms",
+               interval_names[i], type_names[k], r.noise, r.noise / r.raw * 100, r.step_ms, r.ramp_ms);
+      TEST_MESSAGE(msg);
+      if (types[k] == KALMAN_OLD) {
+        old = r;
+        }
+      if (types[k] == filter_kalman) {
+        TEST_ASSERT_TRUE_MESSAGE(r.noise <= r.raw, msg);
+        TEST_ASSERT_TRUE_MESSAGE(r.noise <= old.noise * 1.05f, msg);
+        TEST_ASSERT_TRUE_MESSAGE(r.step_ms < STEP_MAX_US / 1000, msg);
+        if (intervals[i] <= 1000) {
+          TEST_ASSERT_TRUE_MESSAGE(r.noise < old.noise / 2, msg);
+          }
+        }
+      }
+    }
+}
+
+/* Kalman noise at the time between readings of every bucket: the output never has more noise than
+   the readings, buckets that would only filter a little pass the readings through */
+void test_bucket_noise(void) {
+  for (uint32_t i = 0; i < kalman_buckets; i++) {
+    int32_t interval = (int32_t)((uint32_t)kalman_bucket_us << i);
+    speed_filter_state f;
+    speed_filter_reset(&f);
+    seed = 12345;
+    double sq = 0;
+    double raw_sq = 0;
+    for (uint32_t n = 0; n < BUCKET_READINGS; n++) {
+      int32_t z = q16(20 + NOISE_MPH * gauss());
+      float out = (float)speed_filter(&f, filter_kalman, z, next_dt(interval)) / 65536;
+      if (n >= BUCKET_READINGS / 10) {
+        sq = sq + (out - 20.0) * (out - 20.0);
+        raw_sq = raw_sq + ((double)z / 65536 - 20.0) * ((double)z / 65536 - 20.0);
+        }
+      }
+    char msg[80];
+    snprintf(msg, sizeof(msg), "kalman bucket %4ld ms  noise %3.0f%% of the readings (model %3.0f%%)",
+             (long)interval / 1000, sqrt(sq / raw_sq) * 100,
+             kalman_noise_ratio((float)interval / 1000000, kalman_gain_for(interval)) * 100);
+    TEST_MESSAGE(msg);
+    TEST_ASSERT_TRUE_MESSAGE(sq <= raw_sq, msg);
+    }
+}
+
+/* Big errors at the shortest time between readings: the alpha-beta rate term used to overflow
+   (beta x error x 1000000 / dt) and turn the rate around. The output has to head to the reading
+   and settle, then follow a normal speed again */
+void test_overflow(void) {
+  static const uint8_t big_types[] = {filter_alpha_beta, filter_kalman, filter_median_kalman};
+  static const char * const big_names[] = {"alpha-beta", "kalman", "median + kalman"};
+  static const int32_t dts[] = {1, 1000, 50000};
+  static const float jumps[] = {200, 2000, 30000};
+  for (uint32_t k = 0; k < sizeof(big_types); k++) {
+    for (uint32_t d = 0; d < sizeof(dts) / sizeof(dts[0]); d++) {
+      for (uint32_t j = 0; j < sizeof(jumps) / sizeof(jumps[0]); j++) {
+        char msg[80];
+        snprintf(msg, sizeof(msg), "%s dt %ld us jump to %.0f mph", big_names[k], (long)dts[d], jumps[j]);
+        speed_filter_state f;
+        speed_filter_reset(&f);
+        speed_filter(&f, big_types[k], 0, dts[d]);
+        int32_t first = speed_filter(&f, big_types[k], q16(jumps[j]), dts[d]);
+        if (big_types[k] != filter_median_kalman) {
+          TEST_ASSERT_TRUE_MESSAGE(first > 0, msg);                //moved towards the reading
+          TEST_ASSERT_TRUE_MESSAGE(f.v > 0, msg);                  //and speeding up
+          }
+        for (uint32_t n = 0; n < 2000; n++) {
+          int32_t x = speed_filter(&f, big_types[k], q16(jumps[j]), dts[d]);
+          TEST_ASSERT_TRUE_MESSAGE(x >= 0, msg);
+          }
+        for (uint32_t n = 0; n < 20000; n++) {
+          speed_filter(&f, big_types[k], q16(20), 1000);
+          }
+        TEST_ASSERT_FLOAT_WITHIN_MESSAGE(0.2f, 20.0f, speed_filter(&f, big_types[k], q16(20), 1000) / 65536.0f, msg);
+        }
+      }
+    }
+}
+
+int main(void) {
+  speed_filter_init();
+  kalman_solve(0.25f, &old_gains);
+  UNITY_BEGIN();
+  RUN_TEST(test_gains);
+  RUN_TEST(test_lag_noise);
+  RUN_TEST(test_bucket_noise);
+  RUN_TEST(test_overflow);
+  return UNITY_END();
+}
@@ -0,0 +1,113 @@
+/**
+ * @file test_speed_fixed.cpp
+ * Fixed point speed readout (speed_math.cpp) against the float math it replaced, over every
+ * calibration number from 1000 to 60000 and pulse counts up to 150 mph in a 250ms gate, in mph
+ * and kph: the text on the screen has to be the same as "%4.1f" (50 and under) or "%4.0f" of the
+ * speed worked out in double. Only a reading sitting on a rounding tie may differ.
+ *
+ * pio test -e native -f test_speed_fixed
+ */
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+#include "speed_math.h"
+
+#define TIE_TOL 0.0005        //a reading this close to a rounding tie may print either way
+
+/* Text of speed `v` the way the screen used to print it */
+static void format_float(char * buf, double v) {
+  if (v <= 50) {
+    snprintf(buf, 16, "%4.1f", v);
+    }
+  else {
+    snprintf(buf, 16, "%4.0f", v);
+    }
+}
+
+/* True if `v` is close to a value where rounding (or the switch to whole numbers at 50) changes the text */
+static bool near_tie(double v) {
+  double tenths = v * 10 - floor(v * 10);
+  double whole = v - floor(v);
+  return fabs(v - 50) < TIE_TOL || fabs(tenths - 0.5) < TIE_TOL * 10 || (v > 50 && fabs(whole - 0.5) < TIE_TOL);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_format_speed(void) {
+  char buf[16];
+  format_speed(buf, 0);
+  TEST_ASSERT_EQUAL_STRING(" 0.0", buf);
+  format_speed(buf, -65536);
+  TEST_ASSERT_EQUAL_STRING(" 0.0", buf);
+  format_speed(buf, 50L << 16);
+  TEST_ASSERT_EQUAL_STRING("50.0", buf);
+  format_speed(buf, (50L << 16) + 1);
+  TEST_ASSERT_EQUAL_STRING("  50", buf);
+  format_speed(buf, 150L << 16);
+  TEST_ASSERT_EQUAL_STRING(" 150", buf);
+  format_speed(buf, 12L << 16 | 0x8000);                   //12.5
+  TEST_ASSERT_EQUAL_STRING("12.5", buf);
+  format_uint(buf, 0);
+  TEST_ASSERT_EQUAL_STRING("0", buf);
+  format_uint(buf, 4294967295UL);
+  TEST_ASSERT_EQUAL_STRING("4294967295", buf);
+}
+
+/* Every reading of the 250ms gate, was speed_fixed_check() run at start up with serial_debug */
+void test_gate_readings(void) {
+  char buf_d[16];
+  char buf_f[16];
+  char buf_q[16];
+  uint32_t checked = 0;
+  uint32_t ties = 0;
+  uint32_t float_differ = 0;
+  for (int cal = 1000; cal <= 60000; cal = cal + 1000) {                            //calibration numbers
+    float constant = ((float)cal * 17.6f) / 3600;
+    uint64_t q_const = speed_q_for_cal(cal);
+    int max_pulse = (int)(constant * 150 / 4);                                      //up to 150 mph in a 250ms gate
+    int step = max_pulse / 200 + 1;
+    for (int pulses = 0; pulses <= max_pulse; pulses = pulses + step) {
+      for (uint8_t u = 1; u <= 2; u++) {                                            //mph and kph
+        double d = (double)pulses * 3600 * 4 / ((double)cal * 17.6);
+        float v = ((float)pulses / (constant / 4));                                 //the old float math
+        int32_t q = gate_speed_q16(pulses, q_const, gate_us);
+        if (u == 2) {
+          d = d * 1.6092;
+          v = v * 1.6092f;
+          q = (int32_t)(((int64_t)q * kph_q30 + (1LL << 29)) >> 30);
+          }
+        format_float(buf_d, d);
+        format_float(buf_f, v);
+        format_speed(buf_q, q);
+        checked = checked + 1;
+        if (strcmp(buf_f, buf_q) != 0) {
+          float_differ = float_differ + 1;
+          }
+        if (strcmp(buf_d, buf_q) != 0) {
+          char msg[120];
+          snprintf(msg, sizeof(msg), "cal %d pulses %d units %u: %.6f prints '%s', fixed point '%s'", cal, pulses,
+                   (unsigned)u, d, buf_d, buf_q);
+          TEST_ASSERT_TRUE_MESSAGE(near_tie(d), msg);
+          ties = ties + 1;
+          }
+        }
+      }
+    }
+  char msg[120];
+  snprintf(msg, sizeof(msg), "%u readings: %u on a rounding tie, %u differ from the old float math",
+           (unsigned)checked, (unsigned)ties, (unsigned)float_differ);
+  TEST_MESSAGE(msg);
+  TEST_ASSERT_GREATER_THAN_UINT32(20000, checked);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_format_speed);
+  RUN_TEST(test_gate_readings);
+  return UNITY_END();
+}
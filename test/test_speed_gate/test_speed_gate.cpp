@@ -0,0 +1,227 @@
+/**
+ * @file test_speed_gate.cpp
+ * Adaptive gate (speed_mode 2) against the fixed 250ms gate on synthetic pulse trains: the timer
+ * interrupt's gate logic from speed_math.h run on simulated pulses with period jitter, for the
+ * error of the readings at steady speeds and the latency after a speed step.
+ *
+ * The simulation follows onTimer_cb and speed_pulse: the gate timer restarts on the first pulse
+ * after a gate closes, the fixed gate is taken every 250ms, the adaptive gate every 10ms tick
+ * through adapt_gate_tick.
+ *
+ * pio test -e native -f test_speed_gate
+ */
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+#include "speed_math.h"
+
+#define SIM_US 60000000ULL   //simulated time per steady speed (60s)
+#define SETTLE_US 3000000    //readings in the first 3s are not counted
+#define JITTER_PCT 10        //pulse period jitter, +-10% like a doppler radar on a rough road
+#define STEP_CNT 20          //speed steps per latency run
+#define STEP_PCT 20          //speed step size
+#define STEP_TOL_PCT 2       //the step is seen when a reading is this close to the new speed
+#define LATENCY_MAX_US 5000000
+
+static const int cals[] = {1000, 6000, 30000};          //calibration numbers (pulses per 300 feet)
+static const float speeds[] = {0.5, 1, 2, 5, 10, 20, 50};
+#define CAL_CNT (sizeof(cals) / sizeof(cals[0]))
+#define SPEED_CNT (sizeof(speeds) / sizeof(speeds[0]))
+
+static uint32_t seed = 1;
+
+static uint32_t rnd(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+struct gate_sim {
+  bool adaptive;
+  uint64_t q_const;
+  float pps_per_mph;                               //pulses per second at 1 mph
+  uint64_t now;                                    //us
+  uint64_t next_pulse;
+  uint64_t next_tick;
+  uint32_t total;                                  //pulse_total
+  uint32_t gate_count;
+  adapt_gate_state adapt;
+  float mph;                                       //true speed of the pulse train
+};
+
+static void sim_init(gate_sim * s, int cal, bool adaptive, float mph) {
+  s->adaptive = adaptive;
+  s->q_const = speed_q_for_cal(cal);
+  s->pps_per_mph = (float)cal * 17.6f / 3600;
+  s->now = 0;
+  s->next_pulse = rnd() % 100000;                  //random phase against the timer
+  s->next_tick = adaptive ? gate_tick_us : gate_us;
+  s->total = 0;
+  s->gate_count = 0;
+  s->adapt.ticks = 0;
+  s->adapt.idle = 0;
+  s->mph = mph;
+}
+
+static uint64_t pulse_period(const gate_sim * s) {
+  double period = 1e6 / (s->pps_per_mph * s->mph);
+  double jitter = 1 + (double)((int32_t)(rnd() % (2 * JITTER_PCT * 100 + 1)) - JITTER_PCT * 100) / 10000;
+  return (uint64_t)(period * jitter + 0.5);
+}
+
+/* Run till the next reading, returns false if none comes before `end` */
+static bool sim_next(gate_sim * s, uint64_t end, int32_t * q16, uint32_t * length) {
+  while (s->now < end) {
+    if (s->next_pulse < s->next_tick) {            //speed_pulse
+      s->now = s->next_pulse;
+      if (s->total == s->gate_count) {             //timer restarts from 0 on the first pulse
+        s->next_tick = s->now + (s->adaptive ? gate_tick_us : gate_us);
+        }
+      s->total = s->total + 1;
+      s->next_pulse = s->now + pulse_period(s);
+      continue;
+      }
+    s->now = s->next_tick;                         //onTimer_cb
+    s->next_tick = s->now + (s->adaptive ? gate_tick_us : gate_us);
+    uint32_t count = s->total - s->gate_count;
+    uint32_t len = gate_us;
+    if (s->adaptive) {
+      len = adapt_gate_tick(&s->adapt, count);
+      if (len == 0) {
+        continue;
+        }
+      }
+    s->gate_count = s->total;
+    *q16 = gate_speed_q16(count, s->q_const, len);
+    *length = len;
+    return true;
+    }
+  return false;
+}
+
+struct steady_result {
+  float err_pct;                                   //rms error of the readings
+  float interval_ms;                               //mean time between readings
+};
+
+static steady_result steady(int cal, bool adaptive, float mph) {
+  gate_sim s;
+  sim_init(&s, cal, adaptive, mph);
+  double sq = 0;
+  uint32_t n = 0;
+  uint64_t first = 0, last = 0;
+  int32_t q16;
+  uint32_t len;
+  while (sim_next(&s, SIM_US, &q16, &len)) {
+    if (s.now < SETTLE_US) {
+      continue;
+      }
+    double e = ((double)q16 / 65536 - mph) / mph;
+    sq = sq + e * e;
+    if (n == 0) {
+      first = s.now;
+      }
+    last = s.now;
+    n = n + 1;
+    }
+  steady_result r;
+  r.err_pct = n ? (float)(sqrt(sq / n) * 100) : 100;
+  r.interval_ms = n > 1 ? (float)(last - first) / (n - 1) / 1000 : SIM_US / 1000;
+  return r;
+}
+
+/* Mean time from a speed step to the first reading within STEP_TOL_PCT of the new speed */
+static float step_latency_ms(int cal, bool adaptive, float mph) {
+  gate_sim s;
+  sim_init(&s, cal, adaptive, mph);
+  double sum = 0;
+  int32_t q16;
+  uint32_t len;
+  for (uint32_t i = 0; i < STEP_CNT; i++) {
+    uint64_t settle = s.now + SETTLE_US + rnd() % gate_us;   //step at a random time in the gate
+    while (sim_next(&s, settle, &q16, &len)) {
+      }
+    s.now = settle;
+    float target = (i % 2 == 0) ? mph * (100 + STEP_PCT) / 100 : mph;
+    s.mph = target;
+    uint64_t step = s.now;
+    uint64_t seen = step + LATENCY_MAX_US;
+    while (sim_next(&s, step + LATENCY_MAX_US, &q16, &len)) {
+      if (fabs((double)q16 / 65536 - target) <= target * STEP_TOL_PCT / 100) {
+        seen = s.now;
+        break;
+        }
+      }
+    sum = sum + (double)(seen - step);
+    }
+  return (float)(sum / STEP_CNT / 1000);
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+/* The gate closes after adapt_target pulses (not before adapt_min_ticks), after adapt_max_ticks
+   at the latest, and reports 0 speed when no pulse came for adapt_max_ticks */
+void test_adapt_gate_tick(void) {
+  adapt_gate_state g = {0, 0};
+  uint32_t t;
+  for (t = 1; t < adapt_max_ticks; t++) {
+    TEST_ASSERT_EQUAL_UINT32(0, adapt_gate_tick(&g, 0));
+    }
+  TEST_ASSERT_EQUAL_UINT32(adapt_max_ticks * gate_tick_us, adapt_gate_tick(&g, 0));
+
+  for (t = 1; t < adapt_min_ticks; t++) {
+    TEST_ASSERT_EQUAL_UINT32(0, adapt_gate_tick(&g, adapt_target * 10));
+    }
+  TEST_ASSERT_EQUAL_UINT32(adapt_min_ticks * gate_tick_us, adapt_gate_tick(&g, adapt_target * 10));
+
+  for (t = 1; t < 20; t++) {
+    TEST_ASSERT_EQUAL_UINT32(0, adapt_gate_tick(&g, adapt_target - 1));
+    }
+  TEST_ASSERT_EQUAL_UINT32(20 * gate_tick_us, adapt_gate_tick(&g, adapt_target));
+
+  for (t = 1; t < adapt_max_ticks; t++) {
+    TEST_ASSERT_EQUAL_UINT32(0, adapt_gate_tick(&g, 1));
+    }
+  TEST_ASSERT_EQUAL_UINT32(adapt_max_ticks * gate_tick_us, adapt_gate_tick(&g, 1));
+}
+
+/* Error, update interval and step latency of both gates. The adaptive gate has to keep about
+   adapt_target pulses of resolution where the 1s gate can collect them, and update at least as
+   often as the fixed gate where pulses are plentiful */
+void test_compare(void) {
+  for (uint32_t c = 0; c < CAL_CNT; c++) {
+    for (uint32_t v = 0; v < SPEED_CNT; v++) {
+      float mph = speeds[v];
+      steady_result fixed = steady(cals[c], false, mph);
+      steady_result adapt = steady(cals[c], true, mph);
+      float fixed_lat = step_latency_ms(cals[c], false, mph);
+      float adapt_lat = step_latency_ms(cals[c], true, mph);
+      char msg[200];
+      snprintf(msg, sizeof(msg),
+               "cal %5d %4.1f mph  error %5.2f%% -> %5.2f%%  update %4.0f -> %4.0f ms  step latency %5.0f -> %5.0f ms",
+               cals[c], mph, fixed.err_pct, adapt.err_pct, fixed.interval_ms, adapt.interval_ms, fixed_lat, adapt_lat);
+      TEST_MESSAGE(msg);
+
+      float pps = (float)cals[c] * 17.6f / 3600 * mph;
+      if (pps >= adapt_target) {                   //the 1s gate collects adapt_target pulses
+        TEST_ASSERT_TRUE_MESSAGE(adapt.err_pct < 2.0f || adapt.err_pct <= fixed.err_pct, msg);
+        }
+      if (pps * gate_us / 1000000 >= 2 * adapt_target) {   //plenty of pulses in a fixed gate
+        TEST_ASSERT_TRUE_MESSAGE(adapt.interval_ms < fixed.interval_ms, msg);
+        TEST_ASSERT_TRUE_MESSAGE(adapt_lat < fixed_lat, msg);
+        }
+      }
+    }
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_adapt_gate_tick);
+  RUN_TEST(test_compare);
+  return UNITY_END();
+}